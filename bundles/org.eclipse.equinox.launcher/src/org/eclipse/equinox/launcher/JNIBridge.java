@@ -14,6 +14,8 @@
  *******************************************************************************/
 package org.eclipse.equinox.launcher;
 
+import java.util.concurrent.BlockingQueue;
+
 /**
  * <b>Note:</b> This class should not be referenced programmatically by
  * other Java code. This class exists only for the purpose of interacting with
@@ -31,6 +33,8 @@ public class JNIBridge {
 
 	private native void _update_splash();
 
+	private native void _update_splash_progress(int done, int total, String label);
+
 	private native long _get_splash_handle();
 
 	private native void _show_splash(String bitmap);
@@ -39,12 +43,20 @@ public class JNIBridge {
 
 	private native String _get_os_recommended_folder();
 
+	private native String _get_framework_location();
+
 	private native int OleInitialize(int reserved);
 
 	private native void OleUninitialize();
 
 	private String library;
 	private boolean libraryLoaded = false;
+	// false once the library turned out to be older than _update_splash_progress
+	private boolean progressSupported = true;
+	// true if an exec'd VM shows the splash itself, see showSplash
+	private boolean ownSplash = false;
+	// an exec'd VM reaches the launcher through its control channel instead
+	private final LauncherControl control = LauncherControl.open();
 
 	/**
 	 * @noreference This constructor is not intended to be referenced by clients.
@@ -79,6 +91,8 @@ public class JNIBridge {
 	 * @noreference This method is not intended to be referenced by clients.
 	 */
 	public boolean setExitData(String sharedId, String data) {
+		if (control != null && control.setExitData(data))
+			return true;
 		try {
 			_set_exit_data(sharedId, data);
 			return true;
@@ -95,6 +109,8 @@ public class JNIBridge {
 	 * @noreference This method is not intended to be referenced by clients
 	 */
 	public boolean setLauncherInfo(String launcher, String name) {
+		if (control != null)
+			return true; // the launcher knows
 		try {
 			_set_launcher_info(launcher, name);
 			return true;
@@ -111,6 +127,8 @@ public class JNIBridge {
 	 * @noreference This method is not intended to be referenced by clients.
 	 */
 	public boolean showSplash(String bitmap) {
+		if (control != null && (showOwnSplash(bitmap) || control.showSplash(bitmap)))
+			return true;
 		try {
 			_show_splash(bitmap);
 			return true;
@@ -123,10 +141,37 @@ public class JNIBridge {
 		}
 	}
 
+	/*
+	 * A splash handler needs the handle of a splash window in this process.  If the launcher
+	 * library can show one here the launcher takes down the splash it showed meanwhile,
+	 * otherwise the launcher's splash stays and this VM drives it through the channel.
+	 */
+	private boolean showOwnSplash(String bitmap) {
+		if (library == null)
+			return false;
+		try {
+			_show_splash(bitmap);
+			long handle = _get_splash_handle();
+			if (handle == 0 || handle == -1)
+				return false;
+		} catch (UnsatisfiedLinkError e) {
+			if (!libraryLoaded) {
+				loadLibrary();
+				return showOwnSplash(bitmap);
+			}
+			return false;
+		}
+		ownSplash = true;
+		control.hideSplash();
+		return true;
+	}
+
 	/**
 	 * @noreference This method is not intended to be referenced by clients.
 	 */
 	public boolean updateSplash() {
+		if (control != null && !ownSplash)
+			return true; // the launcher pumps its splash itself
 		try {
 			_update_splash();
 			return true;
@@ -139,10 +184,36 @@ public class JNIBridge {
 		}
 	}
 
+	/**
+	 * Shows startup progress on the splash screen drawn by the launcher.  A launcher library
+	 * older than the progress bar only gets its splash pumped.
+	 * 
+	 * @noreference This method is not intended to be referenced by clients.
+	 */
+	public boolean updateSplashProgress(int done, int total, String label) {
+		if (control != null && !ownSplash && control.updateSplashProgress(done, total, label))
+			return true;
+		if (!progressSupported)
+			return updateSplash();
+		try {
+			_update_splash_progress(done, total, label);
+			return true;
+		} catch (UnsatisfiedLinkError e) {
+			if (!libraryLoaded) {
+				loadLibrary();
+				return updateSplashProgress(done, total, label);
+			}
+			progressSupported = false;
+			return updateSplash();
+		}
+	}
+
 	/**
 	 * @noreference This method is not intended to be referenced by clients.
 	 */
 	public long getSplashHandle() {
+		if (control != null && !ownSplash)
+			return 0; // the splash is a window of the launcher's process
 		try {
 			return _get_splash_handle();
 		} catch (UnsatisfiedLinkError e) {
@@ -165,10 +236,26 @@ public class JNIBridge {
 		return libraryLoaded;
 	}
 
+	/**
+	 * Whether the launcher exec'd this VM and draws the splash itself,
+	 * which Java then can't get a handle of.
+	 * 
+	 * @return boolean
+	 */
+	boolean isControlledByLauncher() {
+		return control != null && !ownSplash;
+	}
+
 	/**
 	 * @noreference This method is not intended to be referenced by clients.
 	 */
 	public boolean takeDownSplash() {
+		if (control != null) {
+			// the library takes down the splash of this VM and does the work of a startup
+			// in this process, the prefetch record and the profile; the launcher does its part
+			boolean down = library != null && takeDownOwnSplash();
+			return control.takeDownSplash() || down;
+		}
 		try {
 			_takedown_splash();
 			return true;
@@ -181,6 +268,19 @@ public class JNIBridge {
 		}
 	}
 
+	private boolean takeDownOwnSplash() {
+		try {
+			_takedown_splash();
+			return true;
+		} catch (UnsatisfiedLinkError e) {
+			if (!libraryLoaded) {
+				loadLibrary();
+				return takeDownOwnSplash();
+			}
+			return false;
+		}
+	}
+
 	/**
 	 * @noreference This method is not intended to be referenced by clients.
 	 */
@@ -209,4 +309,31 @@ public class JNIBridge {
 			return null;
 		}
 	}
+
+	/**
+	 * Pass the files other launchers hand to this instance to files, returns
+	 * <code>false</code> if the launcher can't.  Only a VM the launcher exec'd gets
+	 * them this way, SWT gets them over D-Bus.
+	 */
+	boolean acceptOpenFiles(BlockingQueue<String> files) {
+		return control != null && control.acceptOpenFiles(files);
+	}
+
+	/**
+	 * Returns the framework bundle the native launcher found while looking for
+	 * the startup jar, or <code>null</code>.
+	 * 
+	 * @noreference This method is not intended to be referenced by clients.
+	 */
+	public String getFrameworkLocation() {
+		try {
+			return _get_framework_location();
+		} catch (UnsatisfiedLinkError e) {
+			if (!libraryLoaded) {
+				loadLibrary();
+				return getFrameworkLocation();
+			}
+			return null;
+		}
+	}
 }
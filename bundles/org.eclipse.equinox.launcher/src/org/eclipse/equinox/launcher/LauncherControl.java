@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+package org.eclipse.equinox.launcher;
+
+import java.io.*;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * The control channel of a VM the native launcher exec'd instead of running it in
+ * its own process.  The launcher passes a pipe in the eclipse.launcher.control
+ * property, the calls of the {@link JNIBridge} go there as lines of text, and the
+ * launcher draws the splash and keeps the exit data.  The files other launchers hand
+ * to this instance come the other way, through the pipe in eclipse.launcher.control.files.
+ */
+final class LauncherControl {
+	private static final String PROP_CONTROL = "eclipse.launcher.control"; //$NON-NLS-1$
+	private static final String PROP_CONTROL_FILES = "eclipse.launcher.control.files"; //$NON-NLS-1$
+	private static final String OPEN = "open "; //$NON-NLS-1$
+	// seconds a handed over file waits for the application, the launcher waits a little longer
+	private static final int OPEN_TIMEOUT = 3;
+
+	private final OutputStream out;
+
+	private LauncherControl(OutputStream out) {
+		this.out = out;
+	}
+
+	/**
+	 * Whether the launcher that started this VM passed a channel.
+	 */
+	static boolean isAvailable() {
+		return System.getProperty(PROP_CONTROL) != null;
+	}
+
+	/**
+	 * Returns the channel of the launcher that started this VM, or <code>null</code>.
+	 */
+	static LauncherControl open() {
+		String path = System.getProperty(PROP_CONTROL);
+		if (path == null)
+			return null;
+		try {
+			return new LauncherControl(new FileOutputStream(path));
+		} catch (IOException e) {
+			return null;
+		} catch (SecurityException e) {
+			return null;
+		}
+	}
+
+	boolean showSplash(String bitmap) {
+		return send("splash", bitmap); //$NON-NLS-1$
+	}
+
+	boolean updateSplashProgress(int done, int total, String label) {
+		return send("progress", done + " " + total + " " + (label != null ? label : "")); //$NON-NLS-1$ //$NON-NLS-2$ //$NON-NLS-3$ //$NON-NLS-4$
+	}
+
+	boolean hideSplash() {
+		return send("hidesplash", null); //$NON-NLS-1$
+	}
+
+	boolean takeDownSplash() {
+		return send("takedown", null); //$NON-NLS-1$
+	}
+
+	boolean setExitData(String data) {
+		return send("exitdata", data); //$NON-NLS-1$
+	}
+
+	/**
+	 * Ask the launcher for the files other launchers hand to this instance, a daemon
+	 * thread offers them to files as they come and tells the launcher whether the
+	 * application took each in time.  Returns <code>false</code> if the launcher has
+	 * no channel for them.
+	 */
+	boolean acceptOpenFiles(final BlockingQueue<String> files) {
+		String path = System.getProperty(PROP_CONTROL_FILES);
+		if (path == null)
+			return false;
+		final BufferedReader in;
+		try {
+			in = new BufferedReader(new InputStreamReader(new FileInputStream(path), "UTF-8")); //$NON-NLS-1$
+		} catch (IOException e) {
+			return false;
+		} catch (SecurityException e) {
+			return false;
+		}
+		// what the launcher writes meanwhile waits in the pipe
+		if (!send("openfiles", null)) { //$NON-NLS-1$
+			try {
+				in.close();
+			} catch (IOException e) {
+				// nothing was read
+			}
+			return false;
+		}
+		Thread reader = new Thread("Launcher Open Files") { //$NON-NLS-1$
+			@Override
+			public void run() {
+				try {
+					// the launcher keeps the pipe open, this ends with the VM
+					for (String line; (line = in.readLine()) != null;) {
+						if (line.startsWith(OPEN)) {
+							boolean taken = files.offer(unescape(line.substring(OPEN.length())), OPEN_TIMEOUT, TimeUnit.SECONDS);
+							send(taken ? "taken" : "refused", null); //$NON-NLS-1$ //$NON-NLS-2$
+						}
+					}
+				} catch (IOException e) {
+					// the launcher went away
+				} catch (InterruptedException e) {
+					// the VM is going down
+				}
+			}
+		};
+		reader.setDaemon(true);
+		reader.start();
+		return true;
+	}
+
+	private static String unescape(String line) {
+		StringBuilder result = new StringBuilder(line.length());
+		for (int i = 0; i < line.length(); i++) {
+			char c = line.charAt(i);
+			if (c == '\\' && i + 1 < line.length()) {
+				c = line.charAt(++i);
+				result.append(c == 'n' ? '\n' : c == 'r' ? '\r' : c);
+			} else {
+				result.append(c);
+			}
+		}
+		return result.toString();
+	}
+
+	private synchronized boolean send(String command, String argument) {
+		StringBuilder message = new StringBuilder(command);
+		if (argument != null) {
+			message.append(' ');
+			for (int i = 0; i < argument.length(); i++) {
+				char c = argument.charAt(i);
+				if (c == '\\')
+					message.append("\\\\"); //$NON-NLS-1$
+				else if (c == '\n')
+					message.append("\\n"); //$NON-NLS-1$
+				else if (c == '\r')
+					message.append("\\r"); //$NON-NLS-1$
+				else
+					message.append(c);
+			}
+		}
+		message.append('\n');
+		try {
+			// one write, so that messages up to PIPE_BUF arrive whole
+			out.write(message.toString().getBytes("UTF-8")); //$NON-NLS-1$
+			out.flush();
+			return true;
+		} catch (IOException e) {
+			return false;
+		}
+	}
+}
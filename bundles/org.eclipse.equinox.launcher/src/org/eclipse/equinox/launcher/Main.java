@@ -25,6 +25,8 @@ import java.net.*;
 import java.nio.charset.StandardCharsets;
 import java.security.*;
 import java.util.*;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.SynchronousQueue;
 import java.util.zip.ZipEntry;
 import java.util.zip.ZipFile;
 import org.eclipse.equinox.internal.launcher.Constants;
@@ -106,6 +108,7 @@ public class Main {
 	String[] extensionPaths = null;
 
 	JNIBridge bridge = null;
+	private Class<?> framework = null; // EclipseStarter, once loaded
 
 	// splash handling
 	private boolean showSplash = false;
@@ -113,11 +116,20 @@ public class Main {
 	private String endSplash = null;
 	private boolean initialize = false;
 	protected boolean splashDown = false;
+	private boolean startupReported = false;
+	private boolean openFilesAccepted = false;
 
 	public final class SplashHandler extends Thread {
 		@Override
 		public void run() {
+			// the framework calls us directly once the application is running,
+			// don't checkpoint when running as a shutdown hook
+			boolean running = Thread.currentThread() != this;
+			if (running)
+				checkpoint();
 			takeDownSplash();
+			if (running)
+				acceptOpenFiles();
 		}
 
 		public void updateSplash() {
@@ -125,6 +137,12 @@ public class Main {
 				bridge.updateSplash();
 			}
 		}
+
+		public void updateSplash(int done, int total, String label) {
+			if (bridge != null && !splashDown) {
+				bridge.updateSplashProgress(done, total, label);
+			}
+		}
 	}
 
 	private final Thread splashHandler = new SplashHandler();
@@ -220,6 +238,12 @@ public class Main {
 	private static final String PROP_VMARGS = "eclipse.vmargs"; //$NON-NLS-1$
 	private static final String PROP_COMMANDS = "eclipse.commands"; //$NON-NLS-1$
 	private static final String PROP_ECLIPSESECURITY = "eclipse.security"; //$NON-NLS-1$
+	private static final String PROP_CHECKPOINT = "eclipse.checkpoint"; //$NON-NLS-1$
+	private static final String PROP_RESTORE_EXITDATA = "eclipse.restore.exitdata"; //$NON-NLS-1$
+	private static final String LOCATION = "org.eclipse.osgi.service.datalocation.Location"; //$NON-NLS-1$
+	private static final String INSTANCE_AREA_FILTER = "(type=osgi.instance.area)"; //$NON-NLS-1$
+	private static final String OPEN_FILES_NAME = "openfiles"; //$NON-NLS-1$
+	private static final String PROP_LAUNCHER_FRAMEWORK = "eclipse.launcher.framework"; //$NON-NLS-1$
 
 	// Suffix for location properties - see LocationManager.
 	private static final String READ_ONLY_AREA_SUFFIX = ".readOnly"; //$NON-NLS-1$
@@ -447,7 +471,7 @@ public class Main {
 			libPath = getLibraryPath(getFragmentString(fragmentOS, fragmentWS, fragmentArch), defaultPath);
 		}
 		library = libPath;
-		if (library != null)
+		if (library != null || LauncherControl.isAvailable())
 			bridge = new JNIBridge(library);
 	}
 
@@ -654,6 +678,7 @@ public class Main {
 		@SuppressWarnings("resource")
 		URLClassLoader loader = new StartupClassLoader(bootPath, parent);
 		Class<?> clazz = loader.loadClass(STARTER);
+		framework = clazz;
 		Method method = clazz.getDeclaredMethod("run", String[].class, Runnable.class); //$NON-NLS-1$
 		try {
 			method.invoke(clazz, passThruArgs, splashHandler);
@@ -1006,7 +1031,8 @@ public class Main {
 			// search in the root location
 			url = getInstallLocation();
 			String path = new File(url.getFile(), "plugins").toString(); //$NON-NLS-1$
-			path = searchFor(framework, path);
+			String launcherFramework = getLauncherFramework(path);
+			path = launcherFramework != null ? launcherFramework : searchFor(framework, path);
 			if (path == null)
 				throw new RuntimeException("Could not find framework"); //$NON-NLS-1$
 			if (url.getProtocol().equals("file")) //$NON-NLS-1$
@@ -1028,6 +1054,34 @@ public class Main {
 		return result;
 	}
 
+	/*
+	 * Returns the framework the native launcher found in the given plugins directory while
+	 * looking for the startup jar, so that we do not have to scan the directory again.
+	 * An executable that starts the VM in-process hands it over through the JNI bridge,
+	 * one that execs java passes it in a system property.
+	 */
+	private String getLauncherFramework(String pluginsDir) {
+		if (!OSGI.equals(framework))
+			return null;
+		String location = System.getProperty(PROP_LAUNCHER_FRAMEWORK);
+		if (location == null && library != null) {
+			// this is the bridge setupJNI would create
+			File lib = new File(library);
+			if (bridge == null && lib.isFile()) {
+				library = lib.getAbsolutePath();
+				bridge = new JNIBridge(library);
+			}
+			if (bridge != null)
+				location = bridge.getFrameworkLocation();
+		}
+		if (location == null)
+			return null;
+		File candidate = new File(location).getAbsoluteFile();
+		if (!candidate.exists() || !new File(pluginsDir).getAbsoluteFile().equals(candidate.getParentFile()))
+			return null;
+		return candidate.getPath().replace(File.separatorChar, '/') + (candidate.isDirectory() ? "/" : ""); //$NON-NLS-1$//$NON-NLS-2$
+	}
+
 	/**
 	 * Searches for the given target directory starting in the "plugins" subdirectory
 	 * of the given location.  If one is found then this location is returned; 
@@ -2203,20 +2257,140 @@ public class Main {
 			System.getProperties().put(SPLASH_HANDLE, String.valueOf(handle));
 			System.getProperties().put(SPLASH_LOCATION, splashLocation);
 			bridge.updateSplash();
-		} else {
+		} else if (!bridge.isControlledByLauncher()) {
 			// couldn't show the splash screen for some reason
 			splashDown = true;
 		}
 	}
 
+	/*
+	 * Checkpoint the VM with CRaC if the launcher asked for it (--launcher.checkpoint/--launcher.restore).
+	 * The VM exits once the checkpoint is written; the call returns in the VM restored from it, which
+	 * must report its exit data to the launcher that restored it.  CRaC refuses to checkpoint a VM
+	 * that holds file locks, the lock of the instance area is given up for the checkpoint and taken
+	 * again in the restored VM.
+	 */
+	protected void checkpoint() {
+		if (!Boolean.getBoolean(PROP_CHECKPOINT))
+			return;
+		System.getProperties().remove(PROP_CHECKPOINT);
+		Object instanceArea = releaseInstanceArea();
+		try {
+			Class<?> core = Class.forName("jdk.crac.Core"); //$NON-NLS-1$
+			core.getMethod("checkpointRestore").invoke(null); //$NON-NLS-1$
+		} catch (Throwable e) {
+			reportCheckpointFailure(e);
+			return;
+		} finally {
+			lockInstanceArea(instanceArea);
+		}
+		String data = System.getProperty(PROP_RESTORE_EXITDATA);
+		if (data != null)
+			exitData = data;
+	}
+
+	/*
+	 * The launcher starts the next VM the normal way, say why it can't be restored from an image.
+	 */
+	private void reportCheckpointFailure(Throwable e) {
+		if (e instanceof InvocationTargetException && e.getCause() != null)
+			e = e.getCause();
+		System.err.println("Checkpoint failed, running without one: " + e); //$NON-NLS-1$
+		// a CheckpointException lists each resource that prevented the checkpoint
+		for (Throwable reason : e.getSuppressed())
+			System.err.println("\t" + reason); //$NON-NLS-1$
+		if (debug)
+			e.printStackTrace();
+	}
+
+	/*
+	 * Release the lock of the instance area if it is held, returns the Location to lock again.
+	 */
+	private Object releaseInstanceArea() {
+		if (framework == null)
+			return null;
+		try {
+			ClassLoader loader = framework.getClassLoader();
+			Class<?> contextClass = loader.loadClass("org.osgi.framework.BundleContext"); //$NON-NLS-1$
+			Class<?> referenceClass = loader.loadClass("org.osgi.framework.ServiceReference"); //$NON-NLS-1$
+			Class<?> locationClass = loader.loadClass(LOCATION);
+			Object context = framework.getMethod("getSystemBundleContext").invoke(null); //$NON-NLS-1$
+			if (context == null)
+				return null;
+			Object[] references = (Object[]) contextClass.getMethod("getServiceReferences", String.class, String.class).invoke(context, LOCATION, INSTANCE_AREA_FILTER); //$NON-NLS-1$
+			if (references == null || references.length == 0)
+				return null;
+			Object location = contextClass.getMethod("getService", referenceClass).invoke(context, references[0]); //$NON-NLS-1$
+			if (location == null || ((Boolean) locationClass.getMethod("isReadOnly").invoke(location)).booleanValue()) //$NON-NLS-1$
+				return null;
+			if (!((Boolean) locationClass.getMethod("isLocked").invoke(location)).booleanValue()) //$NON-NLS-1$
+				return null;
+			locationClass.getMethod("release").invoke(location); //$NON-NLS-1$
+			return location;
+		} catch (Throwable e) {
+			if (debug)
+				e.printStackTrace();
+			return null;
+		}
+	}
+
+	private void lockInstanceArea(Object location) {
+		if (location == null)
+			return;
+		try {
+			// the implementation class is not public, go through the interface
+			Class<?> locationClass = framework.getClassLoader().loadClass(LOCATION);
+			Object locked = locationClass.getMethod("lock").invoke(location); //$NON-NLS-1$
+			if (!((Boolean) locked).booleanValue())
+				System.err.println("The instance area is in use by another process after the checkpoint."); //$NON-NLS-1$
+		} catch (Throwable e) {
+			System.err.println("Could not lock the instance area after the checkpoint: " + e); //$NON-NLS-1$
+		}
+	}
+
+	/*
+	 * Offer the files other launchers hand to this running instance (--launcher.openFile) to
+	 * the application, as a java.util.concurrent.BlockingQueue service with name=openfiles.
+	 * The queue holds no files: a file is only handed over once the application takes or polls
+	 * it, the launcher that handed it over reports it otherwise.  Only an exec'd VM gets them
+	 * this way, SWT gets them as SWT.OpenDocument events.
+	 */
+	protected void acceptOpenFiles() {
+		if (bridge == null || framework == null || openFilesAccepted)
+			return;
+		openFilesAccepted = true;
+		BlockingQueue<String> files = new SynchronousQueue<String>();
+		if (!bridge.acceptOpenFiles(files))
+			return;
+		try {
+			Class<?> contextClass = framework.getClassLoader().loadClass("org.osgi.framework.BundleContext"); //$NON-NLS-1$
+			Object context = framework.getMethod("getSystemBundleContext").invoke(null); //$NON-NLS-1$
+			if (context == null)
+				return;
+			Dictionary<String, Object> properties = new Hashtable<String, Object>();
+			properties.put("name", OPEN_FILES_NAME); //$NON-NLS-1$
+			contextClass.getMethod("registerService", String.class, Object.class, Dictionary.class).invoke(context, BlockingQueue.class.getName(), files, properties); //$NON-NLS-1$
+		} catch (Throwable e) {
+			if (debug)
+				e.printStackTrace();
+		}
+	}
+
 	/*
 	 * Take down the splash screen. 
 	 */
 	protected void takeDownSplash() {
-		if (splashDown || bridge == null) // splash is already down
+		if (bridge == null)
 			return;
+		if (splashDown) { // splash is already down
+			// the launcher still waits for startup to complete, for example to let the next instance start
+			if (!startupReported)
+				startupReported = bridge.takeDownSplash();
+			return;
+		}
 
 		splashDown = bridge.takeDownSplash();
+		startupReported = splashDown;
 		System.getProperties().remove(SPLASH_HANDLE);
 
 		try {
@@ -21,6 +21,7 @@ public class AllTests {
 		suite.addTest(EnvironmentInfoTest.suite());
 		suite.addTest(FilePathTest.suite());
 		suite.addTest(new JUnit4TestAdapter(LocaleTransformationTest.class));
+		suite.addTest(StartupMonitorTest.suite());
 		return suite;
 	}
 }
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+package org.eclipse.osgi.tests.eclipseadaptor;
+
+import junit.framework.Test;
+import junit.framework.TestSuite;
+import org.eclipse.core.runtime.internal.adaptor.DefaultStartupMonitor;
+import org.eclipse.osgi.tests.OSGiTest;
+
+public class StartupMonitorTest extends OSGiTest {
+
+	/* the splash handler of a launcher that draws a progress bar */
+	public static class ProgressSplashHandler implements Runnable {
+		int updates;
+		int done = -1;
+		int total = -1;
+		String label;
+
+		public void run() {
+			// nothing
+		}
+
+		public void updateSplash() {
+			updates++;
+		}
+
+		public void updateSplash(int done, int total, String label) {
+			this.done = done;
+			this.total = total;
+			this.label = label;
+		}
+	}
+
+	/* the splash handler of a launcher older than the progress bar */
+	public static class PlainSplashHandler implements Runnable {
+		int updates;
+
+		public void run() {
+			// nothing
+		}
+
+		public void updateSplash() {
+			updates++;
+		}
+	}
+
+	public static class FailingSplashHandler implements Runnable {
+		public void run() {
+			// nothing
+		}
+
+		public void updateSplash() {
+			throw new IllegalStateException();
+		}
+
+		public void updateSplash(int done, int total, String label) {
+			throw new IllegalStateException();
+		}
+	}
+
+	public static Test suite() {
+		return new TestSuite(StartupMonitorTest.class);
+	}
+
+	public StartupMonitorTest(String name) {
+		super(name);
+	}
+
+	public void testUpdateProgress() {
+		ProgressSplashHandler handler = new ProgressSplashHandler();
+		DefaultStartupMonitor monitor = new DefaultStartupMonitor(handler, null);
+		monitor.update(3, 10, "org.eclipse.osgi");
+		assertEquals("1.0", 3, handler.done);
+		assertEquals("1.1", 10, handler.total);
+		assertEquals("1.2", "org.eclipse.osgi", handler.label);
+		assertEquals("1.3", 0, handler.updates);
+
+		monitor.update(4, 10, null);
+		assertEquals("2.0", 4, handler.done);
+		assertNull("2.1", handler.label);
+
+		monitor.update();
+		assertEquals("3.0", 1, handler.updates);
+	}
+
+	public void testUpdateProgressOldLauncher() {
+		PlainSplashHandler handler = new PlainSplashHandler();
+		DefaultStartupMonitor monitor = new DefaultStartupMonitor(handler, null);
+		monitor.update(3, 10, "org.eclipse.osgi");
+		monitor.update(4, 10, "org.eclipse.osgi");
+		assertEquals("1.0", 2, handler.updates);
+	}
+
+	public void testUpdateProgressFailure() {
+		DefaultStartupMonitor monitor = new DefaultStartupMonitor(new FailingSplashHandler(), null);
+		// best effort, the splash handler failing doesn't fail the startup
+		monitor.update(3, 10, "org.eclipse.osgi");
+		monitor.update();
+	}
+
+	public void testNoSplashHandler() {
+		try {
+			new DefaultStartupMonitor(new Runnable() {
+				public void run() {
+					// nothing
+				}
+			}, null);
+			fail("Expected a splash handler without updateSplash to be rejected");
+		} catch (IllegalStateException e) {
+			// expected
+		}
+	}
+}
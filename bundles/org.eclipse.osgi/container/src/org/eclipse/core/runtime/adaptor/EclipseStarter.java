@@ -1149,6 +1149,7 @@ public class EclipseStarter {
 	static class StartupEventListener implements SynchronousBundleListener, FrameworkListener {
 		private final Semaphore semaphore;
 		private final int frameworkEventType;
+		volatile String lastBundle;
 
 		public StartupEventListener(Semaphore semaphore, int frameworkEventType) {
 			this.semaphore = semaphore;
@@ -1158,6 +1159,8 @@ public class EclipseStarter {
 		public void bundleChanged(BundleEvent event) {
 			if (event.getBundle().getBundleId() == 0 && event.getType() == BundleEvent.STOPPING)
 				semaphore.release();
+			else if (event.getType() == BundleEvent.RESOLVED || event.getType() == BundleEvent.STARTING)
+				lastBundle = event.getBundle().getSymbolicName();
 		}
 
 		public void frameworkEvent(FrameworkEvent event) {
@@ -1180,7 +1183,10 @@ public class EclipseStarter {
 				StartupMonitor monitor = monitorTracker.getService();
 				if (monitor != null) {
 					try {
-						monitor.update();
+						if (monitor instanceof DefaultStartupMonitor && listener != null)
+							updateProgress((DefaultStartupMonitor) monitor, listener.lastBundle);
+						else
+							monitor.update();
 					} catch (Throwable e) {
 						// ignore exceptions thrown by the monitor
 					}
@@ -1202,6 +1208,26 @@ public class EclipseStarter {
 		}
 	}
 
+	/*
+	 * Report the bundles started so far, out of the bundles that are started
+	 * at the target start level, to the splash the launcher draws.
+	 */
+	private static void updateProgress(DefaultStartupMonitor monitor, String label) {
+		int startLevel = getStartLevel();
+		int done = 0;
+		int total = 0;
+		for (Bundle bundle : context.getBundles()) {
+			boolean started = (bundle.getState() & (Bundle.STARTING | Bundle.ACTIVE)) != 0;
+			BundleStartLevel bundleStartLevel = bundle.adapt(BundleStartLevel.class);
+			if (!started && (bundleStartLevel == null || !bundleStartLevel.isPersistentlyStarted() || bundleStartLevel.getStartLevel() > startLevel))
+				continue;
+			total++;
+			if (started)
+				done++;
+		}
+		monitor.update(done, total, label);
+	}
+
 	/**
 	 * Searches for the given target directory immediately under
 	 * the given start location.  If one is found then this location is returned; 
@@ -22,6 +22,7 @@ import org.eclipse.osgi.service.runnable.StartupMonitor;
 public class DefaultStartupMonitor implements StartupMonitor {
 
 	private final Method updateMethod;
+	private final Method progressMethod;
 	private final Runnable splashHandler;
 	private final EquinoxConfiguration equinoxConfig;
 
@@ -44,6 +45,16 @@ public class DefaultStartupMonitor implements StartupMonitor {
 			//TODO maybe we could do something else in the update method in this case, like print something to the console?
 			throw new IllegalStateException(e.getMessage(), e);
 		}
+		progressMethod = findProgressMethod(splashHandler);
+	}
+
+	private static Method findProgressMethod(Runnable splashHandler) {
+		try {
+			return splashHandler.getClass().getMethod("updateSplash", int.class, int.class, String.class); //$NON-NLS-1$
+		} catch (Exception e) {
+			// an older launcher, it can only pump the splash
+			return null;
+		}
 	}
 
 	/* (non-Javadoc)
@@ -61,6 +72,22 @@ public class DefaultStartupMonitor implements StartupMonitor {
 		}
 	}
 
+	/**
+	 * Update the splash with the startup progress, done of total bundles.
+	 * The label may be <code>null</code>.
+	 */
+	public void update(int done, int total, String label) {
+		if (progressMethod == null) {
+			update();
+			return;
+		}
+		try {
+			progressMethod.invoke(splashHandler, Integer.valueOf(done), Integer.valueOf(total), label);
+		} catch (Throwable e) {
+			// ignore, this is best effort
+		}
+	}
+
 	public void applicationRunning() {
 		if (EclipseStarter.debug) {
 			String timeString = equinoxConfig.getConfiguration("eclipse.startTime"); //$NON-NLS-1$ 
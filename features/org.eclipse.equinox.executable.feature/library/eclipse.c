@@ -85,6 +85,22 @@
  * 							   an executable jar)
  * -library					   the location of the eclipse launcher shared library (this library) to use
  * 							   By default, the launcher exe (see eclipseMain.c) finds
+ * --launcher.checkpoint <dir>  (Linux) start a CRaC capable java executable that checkpoints itself
+ * 							   into <dir> once the application is running, then continue from that image.
+ * --launcher.restore <dir>	   (Linux) restore from the image in <dir> if it matches this launch, otherwise
+ * 							   behave like --launcher.checkpoint.
+ * --launcher.vmVersion <range> (Linux) when no -vm is given and no VM is shipped with eclipse, pick the newest
+ * 							   installed JDK whose version is in the OSGi version <range>, e.g. [17,22).
+ * 							   Fails to start when no installed JDK is in the range.
+ * --launcher.vmVendor <name>  (Linux) prefer installed JDKs whose release file names <name> as IMPLEMENTOR
+ * --launcher.secondThread	   start the JVM on a new thread rather than the main thread.  On Linux the
+ * 							   thread gets the stack size of -Xss (or the stack limit) and the main thread
+ * 							   keeps the splash screen responsive while the JVM starts.
+ * --launcher.prefetch		   (Linux) read the VM, the startup jars and the files the previous startup used
+ * 							   into the page cache in the background while the VM is located and created.
+ * --launcher.fastExit <ms>	   when the JVM was started in-process, give it at most <ms> milliseconds
+ * 							   to shut down once the Java application has returned, then flush
+ * 							   stdio and exit with the application's exit code.
  *  <userArgs>                 arguments that are passed along to the Java application
  *                             (i.e, -data <path>, -debug, -console, -consoleLog, etc)
  *  -vmargs <userVMargs> ...   a list of arguments for the VM itself
@@ -146,6 +162,7 @@
 #include "eclipseJNI.h"
 #include "eclipseConfig.h"
 #include "eclipseCommon.h"
+#include "eclipseLaunch.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -156,12 +173,29 @@
 #include <unistd.h>
 #include <strings.h>
 #include <libgen.h>
+#include <fcntl.h>
 #endif
 
 #ifdef MACOSX
 #include <Cocoa/Cocoa.h>
 #endif
 
+#ifdef LINUX
+#include "eclipseCheckpoint.h"
+#include "eclipseJdk.h"
+#include "eclipsePrefetch.h"
+#include "eclipseHandoff.h"
+#include "eclipseStall.h"
+#include "eclipseProfile.h"
+#include "eclipseLog.h"
+#include "eclipseCgroup.h"
+#include "eclipseRuntime.h"
+#include "eclipseControl.h"
+#include "eclipseMemory.h"
+#include "eclipseAdmission.h"
+#include <malloc.h>
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -176,16 +210,21 @@
 #define MAX_PATH_LENGTH   2000
 #define MAX_SHARED_LENGTH   (16 * 1024)
 
+/* phases of the startup timed for --launcher.profileStartup */
+#ifdef LINUX
+#define MARK_PHASE(name)	markPhase(name)
+#else
+#define MARK_PHASE(name)
+#endif
+
 /* Global Data */
 static _TCHAR*  program     = NULL;       /* full pathname of the program */
 static _TCHAR*  programDir  = NULL;       /* directory where program resides */
-static _TCHAR*  javaVM      = NULL;       /* full pathname of the Java VM to run */
-static _TCHAR*  jniLib		= NULL;		  /* full path of a java vm library for JNI invocation */
-static _TCHAR*  jarFile     = NULL;		  /* full pathname of the startup jar file to run */
-static _TCHAR*  sharedID    = NULL;       /* ID for the shared memory */
 static _TCHAR*  officialName  = NULL;
 
 _TCHAR*  exitData    = NULL;		  /* exit data set from Java */
+_TCHAR*  frameworkLocation = NULL;	  /* the framework bundle found next to the startup jar */
+_TCHAR*  startupRecording = NULL;	  /* JFR recording to stop when startup is complete */
 int		 initialArgc;
 _TCHAR** initialArgv = NULL;
 
@@ -216,6 +255,10 @@ static _TCHAR* startupMsg =
 _T_ECLIPSE("The %s executable launcher was unable to locate its \n\
 companion launcher jar.");
 
+#if !defined(_WIN32) && !defined(MACOSX)
+static _TCHAR* vmExeMsg = _T_ECLIPSE("%s\nThe Java VM must be started from a java executable.");
+#endif
+
 static _TCHAR* gtk2Msg =
 _T_ECLIPSE("The %s executable launcher no longer supports running with GTK + 2.x. Continuing using GTK+ 3.x.");
 
@@ -223,6 +266,30 @@ static _TCHAR* homeMsg =
 _T_ECLIPSE("The %s executable launcher was unable to locate its \n\
 home directory.");
 
+#ifndef _WIN32
+static _TCHAR* workspaceMsg =
+_T_ECLIPSE("The workspace %s\n\
+is in use by another instance of %s%s.\n\
+Close it or choose a different workspace.");
+#endif
+
+#ifdef LINUX
+static _TCHAR* checkpointMsg = _T_ECLIPSE("Checkpoint/restore needs a java executable, ignoring %s.\n");
+static _TCHAR* checkpointDirMsg = _T_ECLIPSE("Unable to create the checkpoint image %s, ignoring it.\n");
+static _TCHAR* execMsg = _T_ECLIPSE("%s needs a java executable, ignoring it.\n");
+static _TCHAR* perfMsg = _T_ECLIPSE("perf was not found on the PATH, starting the VM without it.\n");
+static _TCHAR* logToMsg = _T_ECLIPSE("Unable to write to the log file %s, the VM writes to the console.\n");
+static _TCHAR* perfDataMsg = _T_ECLIPSE("perf data of the VM written to %s\n");
+static _TCHAR* cgroupMsg = _T_ECLIPSE("The VM does not get all of %s:\n%s\n");
+static _TCHAR* cgroupDataMsg = _T_ECLIPSE("Resource pressure of the VM written to %s\n");
+static _TCHAR* runtimeMsg = _T_ECLIPSE("Java runtime written to %s, use it with -vm %s/bin or as the jre directory.\n");
+static _TCHAR* runtimeErrorMsg = _T_ECLIPSE("Unable to build the Java runtime %s:\n%s\n");
+static _TCHAR* memReportMsg = _T_ECLIPSE("Memory report of the VM written to %s\n");
+static _TCHAR* startQueueMsg = _T_ECLIPSE("Waited %ld seconds for one of %d concurrent starts, starting anyway.\n");
+static _TCHAR* vmVersionMsg = _T_ECLIPSE("installed JDKs in the version range %s of --launcher.vmVersion");
+static _TCHAR* vmVendorMsg = _T_ECLIPSE("No installed JDK was found for --launcher.vmVendor %s, using %s from the PATH.\n");
+#endif
+
 #define OLD_STARTUP 		_T_ECLIPSE("startup.jar")
 #define CLASSPATH_PREFIX        _T_ECLIPSE("-Djava.class.path=")
 
@@ -245,6 +312,7 @@ home directory.");
 #define CLASSPATH    _T_ECLIPSE("-classpath")
 #define JAR 		 _T_ECLIPSE("-jar")
 #define PROTECT 	 _T_ECLIPSE("-protect")
+#define DATA		 _T_ECLIPSE("-data")
 
 #define OPENFILE	  _T_ECLIPSE("--launcher.openFile")
 #define DEFAULTACTION _T_ECLIPSE("--launcher.defaultAction")
@@ -256,9 +324,45 @@ home directory.");
 #define OVERRIDE_VMARGS _T_ECLIPSE("--launcher.overrideVmargs")
 #define SECOND_THREAD _T_ECLIPSE("--launcher.secondThread")
 #define PERM_GEN	  _T_ECLIPSE("--launcher.XXMaxPermSize")
+#define FAST_EXIT	  _T_ECLIPSE("--launcher.fastExit")
+#define CHECKPOINT	  _T_ECLIPSE("--launcher.checkpoint")
+#define RESTORE		  _T_ECLIPSE("--launcher.restore")
+#define VM_VERSION	  _T_ECLIPSE("--launcher.vmVersion")
+#define VM_VENDOR	  _T_ECLIPSE("--launcher.vmVendor")
+#define PREFETCH	  _T_ECLIPSE("--launcher.prefetch")
+#define STALL_DUMP	  _T_ECLIPSE("--launcher.stallDump")
+#define PROFILE_STARTUP  _T_ECLIPSE("--launcher.profileStartup")
+#define PROFILE_DURATION _T_ECLIPSE("--launcher.profileDuration")
+#define PERF		  _T_ECLIPSE("--launcher.perf")
+#define PERF_RECORD	  _T_ECLIPSE("--launcher.perfRecord")
+#define LOG_TO		  _T_ECLIPSE("--launcher.logTo")
+#define LOG_MAX_SIZE  _T_ECLIPSE("--launcher.logMaxSize")
+#define LOG_TIMESTAMPS _T_ECLIPSE("--launcher.logTimestamps")
+#define CGROUP		  _T_ECLIPSE("--launcher.cgroup")
+#define BUILD_RUNTIME _T_ECLIPSE("--launcher.buildRuntime")
+#define MEM_REPORT	  _T_ECLIPSE("--launcher.memReport")
+#define MAX_STARTS	  _T_ECLIPSE("--launcher.maxConcurrentStarts")
+#define START_QUEUE_TIMEOUT _T_ECLIPSE("--launcher.startQueueTimeout")
 
 #define XXPERMGEN	  _T_ECLIPSE("-XX:MaxPermSize=")
 #define ADDMODULES	  _T_ECLIPSE("--add-modules")
+#define CRAC_CHECKPOINT _T_ECLIPSE("-XX:CRaCCheckpointTo=")
+#define CRAC_RESTORE  _T_ECLIPSE("-XX:CRaCRestoreFrom=")
+#define CHECKPOINT_PROP _T_ECLIPSE("-Declipse.checkpoint=true")
+#define RESTORE_EXITDATA_PROP _T_ECLIPSE("-Declipse.restore.exitdata=")
+#define FRAMEWORK_PROP			_T_ECLIPSE("-Declipse.launcher.framework=")
+#define CONTROL_PROP			_T_ECLIPSE("-Declipse.launcher.control=")
+#define CONTROL_FILES_PROP		_T_ECLIPSE("-Declipse.launcher.control.files=")
+#define PHASES_PROP				_T_ECLIPSE("-Declipse.launcher.phases=")
+#define START_RECORDING			_T_ECLIPSE("-XX:StartFlightRecording=")
+#define UNLOCK_DIAGNOSTIC		_T_ECLIPSE("-XX:+UnlockDiagnosticVMOptions")
+#define DUMP_PERF_MAP			_T_ECLIPSE("-XX:+DumpPerfMapAtExit")
+#define PRESERVE_FRAME_POINTER	_T_ECLIPSE("-XX:+PreserveFramePointer")
+#define NMT_SUMMARY				_T_ECLIPSE("-XX:NativeMemoryTracking=summary")
+#define INSTANCE_AREA_PROP		_T_ECLIPSE("-Dosgi.instance.area=")
+#define INSTANCE_READONLY_PROP	_T_ECLIPSE("-Dosgi.instance.area.readOnly=")
+#define LOCKING_PROP			_T_ECLIPSE("-Dosgi.locking=")
+#define WORKSPACE_LOCK			_T_ECLIPSE("/.metadata/.lock")
 #define ACTION_OPENFILE _T_ECLIPSE("openFile")
 #define GTK_VERSION   _T_ECLIPSE("--launcher.GTK_version")
 
@@ -274,35 +378,104 @@ home directory.");
 /* Define the variables to receive the option values. */
 static int     needConsole   = 0;				/* True: user wants a console	*/
 static int     debug         = 0;				/* True: output debugging info	*/
+#ifdef HEADLESS
+static int     noSplash      = 1;				/* no window system, and Java must not load one for the splash */
+#else
 static int     noSplash      = 0;				/* True: do not show splash win	*/
+#endif
 static int	   suppressErrors = 0;				/* True: do not display errors dialogs */
        int     secondThread  = 0;				/* True: start the VM on a second thread */
 static int     appendVmargs = 0;                /* True: append cmdline vmargs to launcher.ini vmargs */
+static int     prefetch     = 0;				/* True: prefetch startup files into the page cache */
+static int     profileStartup = 0;			/* True: record the startup with JFR */
+static int     perf         = 0;				/* True: let perf symbolize the JIT compiled code */
+static int     perfRecord   = 0;				/* True: start the VM under perf record */
+static int     logTimestamps = 0;				/* True: prefix the lines relayed to --launcher.logTo with the time */
+static int     memReport    = 0;				/* True: report the memory of the VM at startup and exit */
+       int     fastExitTimeout = -1;			/* milliseconds allowed for VM shutdown, -1 waits forever */
 #ifdef MACOSX
 static int     skipJava9ParamRemoval		 = 0;		/* Set to true only on macOS, if -vm was present on commandline or in eclipse.ini and points to a shared lib */
 #endif
 
 static _TCHAR*  showSplashArg = NULL;			/* showsplash data (main launcher window) */
 static _TCHAR*  splashBitmap  = NULL;			/* the actual splash bitmap */
-static _TCHAR * startupArg    = NULL;			/* path of the startup.jar the user wants to run relative to the program path */
-static _TCHAR*  vmName        = NULL;     		/* Java VM that the user wants to run */
 static _TCHAR*  name          = NULL;			/* program name */
 static _TCHAR*  permGen  	  = NULL;			/* perm gen size for sun */
 static _TCHAR**  filePath	  = NULL;			/* list of files to open */
 static _TCHAR*  timeoutString = NULL;			/* timeout value for opening a file */
+static _TCHAR*  fastExitString = NULL;			/* shutdown budget specified by --launcher.fastExit */
+static _TCHAR*  checkpointDir = NULL;			/* directory for checkpoint images (--launcher.checkpoint) */
+static _TCHAR*  restoreDir    = NULL;			/* directory to restore checkpoint images from (--launcher.restore) */
+static _TCHAR*  stallDumpString = NULL;			/* seconds before a slow startup is sampled (--launcher.stallDump) */
+static _TCHAR*  profileDurationString = NULL;	/* seconds to record instead of until the splash is down (--launcher.profileDuration) */
+static _TCHAR*  logToFile     = NULL;			/* file the output of the VM is relayed to (--launcher.logTo) */
+static _TCHAR*  logMaxSizeString = NULL;		/* size at which that file is rotated (--launcher.logMaxSize) */
+static _TCHAR*  cgroupSpec    = NULL;			/* settings of the cgroup the VM runs in (--launcher.cgroup) */
+static _TCHAR*  maxStartsString = NULL;			/* launchers of the host that may start a VM at once (--launcher.maxConcurrentStarts) */
+static _TCHAR*  startQueueTimeoutString = NULL;	/* seconds to wait for a start slot (--launcher.startQueueTimeout) */
+static _TCHAR*  buildRuntimeDir = NULL;			/* where to build a runtime instead of launching (--launcher.buildRuntime) */
 static _TCHAR*  defaultAction = NULL;			/* default action for non '-' command line arguments */
 static _TCHAR*  iniFile       = NULL;			/* the launcher.ini file set if  --launcher.ini was specified */
 static _TCHAR*  gtkVersionString = NULL;        /* GTK+ version specified by --launcher.GTK_version */
 static _TCHAR*  protectMode   = NULL;			/* Process protectMode specified via -protect, to trigger the reading of eclipse.ini in the configuration (Mac specific currently) */
 
-/* variables for ee options */
-static _TCHAR* eeExecutable = NULL;
-static _TCHAR* eeConsole = NULL;
-static _TCHAR* eeLibrary = NULL;
-
 _TCHAR* eeLibPath = NULL;			/* this one is global so others can see it */
 _TCHAR*  eclipseLibrary = NULL;	/* the shared library */
 
+/* Everything that is specific to one launch of the Java VM.  The launcher itself
+ * uses defaultContext, the embedding API in eclipseLaunch.h creates more.
+ */
+struct LaunchContext {
+	/* options */
+	_TCHAR*  startupArg;		/* path of the startup.jar the user wants to run relative to the program path */
+	_TCHAR*  vmName;			/* Java VM that the user wants to run */
+	_TCHAR*  vmVersion;			/* version range of installed JDKs to pick from */
+	_TCHAR*  vmVendor;			/* preferred vendor of installed JDKs */
+	_TCHAR** userVMarg;			/* user specific args for the Java VM  */
+	int      noSplash;			/* True: do not pass -showsplash to Java */
+	int      argc;				/* remaining program arguments, argv[0] is the program */
+	_TCHAR** argv;
+
+	/* variables for ee options */
+	_TCHAR*  eeExecutable;
+	_TCHAR*  eeConsole;
+	_TCHAR*  eeLibrary;
+	_TCHAR*  eeLibPath;
+	_TCHAR** eeVMarg;			/* vm args specified in ee file */
+	int      nEEargs;
+
+	/* what was found */
+	int      launchMode;		/* LAUNCH_JNI or LAUNCH_EXE */
+	_TCHAR*  javaVM;			/* full pathname of the Java VM to run */
+	_TCHAR*  jniLib;			/* full path of a java vm library for JNI invocation */
+	_TCHAR*  jarFile;			/* full pathname of the startup jar file to run */
+	_TCHAR*  frameworkLocation;	/* the framework bundle next to the startup jar */
+	_TCHAR*  sharedID;			/* ID for the shared memory */
+
+	/* the required VM arguments */
+	_TCHAR*  cp;
+	_TCHAR*  cpValue;
+	_TCHAR*  checkpointArg;		/* -XX:CRaCCheckpointTo=<image> */
+	_TCHAR*  checkpointProp;	/* tells the Java side to checkpoint */
+	_TCHAR*  frameworkProp;		/* framework location for an exec'd VM */
+	_TCHAR*  controlProp;		/* control channel of an exec'd VM */
+	_TCHAR*  controlFilesProp;	/* the files handed to the instance, the other way */
+	_TCHAR*  recordingArg;		/* -XX:StartFlightRecording=... */
+	_TCHAR*  phasesProp;		/* phase timings of the launcher for the recording */
+	_TCHAR*  diagnosticArg;		/* -XX:+UnlockDiagnosticVMOptions for the perf map */
+	_TCHAR*  perfMapArg;		/* -XX:+DumpPerfMapAtExit */
+	_TCHAR*  framePointerArg;	/* -XX:+PreserveFramePointer */
+	_TCHAR*  nmtArg;			/* -XX:NativeMemoryTracking=summary for the memory report */
+
+	/* the command */
+	_TCHAR** vmCommand;			/* exec'd command, LAUNCH_EXE only */
+	_TCHAR** vmCommandArgs;
+	_TCHAR** progCommandArgs;
+	int      process;			/* process id of the exec'd VM, 0 if none */
+};
+
+static LaunchContext defaultContext;
+
 /* Define a table for processing command line options. */
 typedef struct
 {
@@ -320,6 +493,7 @@ typedef struct
 #define ADJUST_PATH		4  	/* value is a path, do processing on relative paths to try and make them absolute */
 #define VALUE_IS_LIST	8  	/* value is a pointer to a tokenized _TCHAR* string for EE files, or a _TCHAR** list for the command line */
 #define INVERT_FLAG    16   /* invert the meaning of a flag, i.e. reset it */
+#define CONTEXT_VALUE  32   /* value is the field of defaultContext, saved in the launch context being parsed */
 
 static Option options[] = {
     { CONSOLE,		&needConsole,	VALUE_IS_FLAG,	0 },
@@ -330,17 +504,36 @@ static Option options[] = {
     { SECOND_THREAD, &secondThread, VALUE_IS_FLAG,  1 },
     { APPEND_VMARGS, &appendVmargs,	VALUE_IS_FLAG, 1 },
     { OVERRIDE_VMARGS, &appendVmargs, VALUE_IS_FLAG | INVERT_FLAG, 1 },
+    { PREFETCH,		&prefetch,		VALUE_IS_FLAG,	1 },
+    { PROFILE_STARTUP, &profileStartup, VALUE_IS_FLAG,	1 },
+    { PERF,			&perf,			VALUE_IS_FLAG,	1 },
+    { PERF_RECORD,	&perfRecord,	VALUE_IS_FLAG,	1 },
+    { LOG_TIMESTAMPS, &logTimestamps, VALUE_IS_FLAG,	1 },
+    { MEM_REPORT,	&memReport,		VALUE_IS_FLAG,	1 },
     { LIBRARY,		NULL,			0,			2 }, /* library was parsed by exe, just remove it */
     { INI,			&iniFile, 		0,			2 },
     { OS,			&osArg,			0,			2 },
     { OSARCH,		&osArchArg,		0,			2 },
     { SHOWSPLASH,   &showSplashArg,	OPTIONAL_VALUE,	2 },
-    { STARTUP,		&startupArg,	0,			2 },
-    { VM,           &vmName,		0,			2 },
+    { STARTUP,		&defaultContext.startupArg,	CONTEXT_VALUE,	2 },
+    { VM,           &defaultContext.vmName,		CONTEXT_VALUE,	2 },
+    { VM_VERSION,	&defaultContext.vmVersion,	CONTEXT_VALUE,	2 },
+    { VM_VENDOR,	&defaultContext.vmVendor,	CONTEXT_VALUE,	2 },
     { NAME,         &name,			0,			2 },
     { PERM_GEN,		&permGen,		0,			2 },
     { OPENFILE,		&filePath,		ADJUST_PATH | VALUE_IS_LIST, -1 },
     { TIMEOUT,		&timeoutString, 0,          2 },
+    { FAST_EXIT,	&fastExitString, 0,         2 },
+    { CHECKPOINT,	&checkpointDir,	ADJUST_PATH,	2 },
+    { RESTORE,		&restoreDir,	ADJUST_PATH,	2 },
+    { STALL_DUMP,	&stallDumpString, 0,		2 },
+    { PROFILE_DURATION, &profileDurationString, 0,	2 },
+    { LOG_TO,		&logToFile,		0,			2 },
+    { LOG_MAX_SIZE,	&logMaxSizeString, 0,		2 },
+    { CGROUP,		&cgroupSpec,	0,			2 },
+    { MAX_STARTS,	&maxStartsString, 0,		2 },
+    { START_QUEUE_TIMEOUT, &startQueueTimeoutString, 0, 2 },
+    { BUILD_RUNTIME, &buildRuntimeDir, 0,		2 },
     { DEFAULTACTION,&defaultAction, 0,			2 },
     { WS,			&wsArg,			0,			2 },
     { GTK_VERSION,  &gtkVersionString, 0,       2 },
@@ -349,41 +542,84 @@ static Option options[] = {
 static int optionsSize = (sizeof(options) / sizeof(options[0]));
 
 static Option eeOptions[] = {
-	{ EE_EXECUTABLE,	&eeExecutable, 	ADJUST_PATH, 0 },
-	{ EE_CONSOLE,	 	&eeConsole,		ADJUST_PATH, 0 },
-	{ EE_VM_LIBRARY, 	&eeLibrary,		ADJUST_PATH, 0 },
-	{ EE_LIBRARY_PATH,	&eeLibPath, 	ADJUST_PATH | VALUE_IS_LIST, 0 }
+	{ EE_EXECUTABLE,	&defaultContext.eeExecutable, 	ADJUST_PATH | CONTEXT_VALUE, 0 },
+	{ EE_CONSOLE,	 	&defaultContext.eeConsole,		ADJUST_PATH | CONTEXT_VALUE, 0 },
+	{ EE_VM_LIBRARY, 	&defaultContext.eeLibrary,		ADJUST_PATH | CONTEXT_VALUE, 0 },
+	{ EE_LIBRARY_PATH,	&defaultContext.eeLibPath, 	ADJUST_PATH | VALUE_IS_LIST | CONTEXT_VALUE, 0 }
 };
 static int eeOptionsSize = (sizeof(eeOptions) / sizeof(eeOptions[0]));
 
 /* Define the required VM arguments (all platforms). */
-static _TCHAR*  cp = NULL;
-static _TCHAR*  cpValue = NULL;
-static _TCHAR** reqVMarg[] = { &cp, &cpValue, NULL };	/* required VM args */
-static _TCHAR** userVMarg  = NULL;	     				/* user specific args for the Java VM  */
-static _TCHAR** eeVMarg = NULL;							/* vm args specified in ee file */
-static int nEEargs = 0;
+#define REQUIRED_VM_ARGS(context) { &(context)->checkpointArg, &(context)->checkpointProp, &(context)->frameworkProp, &(context)->controlProp, &(context)->controlFilesProp, &(context)->recordingArg, &(context)->phasesProp, \
+	&(context)->diagnosticArg, &(context)->perfMapArg, &(context)->framePointerArg, &(context)->nmtArg, &(context)->cp, &(context)->cpValue, NULL }
 
 /* Local methods */
-static void     parseArgs( int* argc, _TCHAR* argv[] );
+static void     parseArgs( LaunchContext* context, int* argc, _TCHAR* argv[] );
 static void 	processDefaultAction(int argc, _TCHAR* argv[]);
 static void 	mergeUserVMArgs( _TCHAR **vmArgs[], _TCHAR** launchersIniVMArgs );
-static void     getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmArgv[], _TCHAR **progArgv[] );
-static int 		determineVM(_TCHAR** msg);
-static int 		vmEEProps(_TCHAR* eeFile, _TCHAR** msg);
-static int 		processEEProps(_TCHAR* eeFile);
+static void     getVMCommand( LaunchContext* context, _TCHAR **vmArgv[], _TCHAR **progArgv[] );
+static void     buildVMCommand( LaunchContext* context );
+static int 		determineVM( LaunchContext* context, _TCHAR** msg );
+static int 		vmEEProps( LaunchContext* context, _TCHAR* eeFile, _TCHAR** msg );
+static int 		processEEProps( LaunchContext* context, _TCHAR* eeFile );
 static _TCHAR** buildLaunchCommand( _TCHAR* program, _TCHAR** vmArgs, _TCHAR** progArgs );
+static void     readExecExitData( LaunchContext* context );
 static _TCHAR** parseArgList( _TCHAR *data );
 static _TCHAR*  formatVmCommandMsg( _TCHAR* args[], _TCHAR* vmArgs[], _TCHAR* progArgs[] );
 static _TCHAR*  getDefaultOfficialName();
-static _TCHAR*  findStartupJar();
+static _TCHAR*  findStartupJar( LaunchContext* context );
 static _TCHAR*  findSplash(_TCHAR* splashArg);
-static _TCHAR** getRelaunchCommand( _TCHAR **vmCommand );
+static _TCHAR** getRelaunchCommand( LaunchContext* context, _TCHAR **vmCommand );
 static const _TCHAR* getVMArch();
 static int      _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]);
 static _TCHAR** mergeConfigurationFilesVMArgs();
 static _TCHAR** extractVMArgs(_TCHAR** launcherIniValues);
+#ifdef LINUX
+static int      prepareCheckpoint( LaunchContext* context );
+static _TCHAR** buildRestoreCommand( LaunchContext* context );
+static void     dropCheckpoint( LaunchContext* context );
+static void     removeCheckpointArgs( _TCHAR* args[] );
+static void     startPrefetch();
+static void     prefetchStartupFiles( LaunchContext* context );
+static void     setLauncherVar( const char* name, _TCHAR* value );
+static void     targetLauncherVars( LaunchContext* context );
+static _TCHAR*  getLauncherVar( const char* name );
+static void     startStallDump( LaunchContext* context );
+static void     prepareStartupProfile( LaunchContext* context );
+static _TCHAR** buildPerfCommand( LaunchContext* context );
+static void     startLog();
+static void     startCgroup();
+static void     startControl( LaunchContext* context );
+static int      openHandedOffFiles( _TCHAR* files[] );
+static void     startHandoff( LaunchContext* context );
+static void     reportMemory( LaunchContext* context, char* event, int process );
+static void     waitForStartSlot();
+static void     startDiscovery( LaunchContext* context );
+static void     joinDiscovery();
+static void     reportPressure();
+static int      createRuntime( LaunchContext* context );
+
+static _TCHAR*  getInstanceSocket( int argc, _TCHAR* argv[], _TCHAR* vmArgs[] );
+
+static _TCHAR*  prefetchRecord = NULL;			/* where Java records the files used by this startup */
+static _TCHAR*  handoffSocket = NULL;			/* where the launchers of this instance hand over files */
+static _TCHAR*  perfProgram = NULL;				/* perf executable (--launcher.perfRecord) */
+static _TCHAR*  perfData = NULL;				/* where perf record writes to */
+static _TCHAR*  memReportFile = NULL;			/* the report of --launcher.memReport */
+static int      startupFd = -1;					/* where to report the startup of the VM to the stall monitor */
+
+static _TCHAR*  checkpointImage = NULL;			/* image to checkpoint to or restore from */
+static _TCHAR*  restoreArg = NULL;				/* -XX:CRaCRestoreFrom=<image> */
+static _TCHAR*  restoreExitDataArg = NULL;		/* exit data id for the restored VM */
+static int      restoring = 0;					/* True: checkpointImage holds a checkpoint we restore from */
+#endif
 
+#ifndef _WIN32
+static void     checkWorkspaceLock( int argc, _TCHAR* argv[], _TCHAR* vmArgs[] );
+#endif
+#if !defined(_WIN32) && !defined(MACOSX)
+static int      determineJavaExe( LaunchContext* context, _TCHAR** msg );
+#endif
 #ifdef _WIN32
 static void     createConsole();
 static void		fixDLLSearchPath();
@@ -398,6 +634,15 @@ JNIEXPORT void setInitialArgs(int argc, _TCHAR** argv, _TCHAR* lib) {
 	eclipseLibrary = lib;
 }
 
+#ifdef LINUX
+static _TCHAR*  embeddedIni = NULL;				/* launcher.ini stamped into the executable (eclipseStamp.h) */
+
+/* The executable has the launcher.ini in memory, it replaces <program>.ini */
+JNIEXPORT void setEmbeddedIni(_TCHAR* ini) {
+	embeddedIni = ini;
+}
+#endif
+
 #ifdef MACOSX
 
 #include <pthread.h>
@@ -427,7 +672,7 @@ JNIEXPORT int run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 
     /* Parse command line arguments (looking for the VM to use). */
     /* Override configuration file arguments */
-    parseArgs( &argc, argv );
+    parseArgs( &defaultContext, &argc, argv );
 
 #ifdef MACOSX
 	if (secondThread != 0) {
@@ -500,15 +745,14 @@ static void handleVMArgs(_TCHAR** vmArgs[]) {
 
 static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 {
-    _TCHAR**  vmCommand = NULL;
-    _TCHAR**  vmCommandArgs = NULL;
-    _TCHAR**  progCommandArgs = NULL;
+    LaunchContext* context = &defaultContext;
     _TCHAR**  relaunchCommand = NULL;
     _TCHAR*   errorMsg = NULL, *msg = NULL;
     JavaResults* javaResults = NULL;
-    int 	  launchMode;
     int 	  running = 1;
 
+	MARK_PHASE("library");
+
 	/* Initialize official program name */
    	officialName = name != NULL ? _tcsdup( name ) : getDefaultOfficialName();
 
@@ -546,6 +790,13 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 #endif
 #endif
 
+#ifdef LINUX
+	/* hand the files to the instance running on this workspace without loading GTK */
+	handoffSocket = getInstanceSocket(argc, argv, vmArgs);
+	if (filePath != NULL && filePath[0] != NULL && handoffSocket != NULL && handOffFiles(handoffSocket, filePath))
+		return 0;
+#endif
+
 	/* try to open the specified file in an already running eclipse */
 	/* on Mac we are only registering an event handler here, always do this */
 #ifndef MACOSX
@@ -587,10 +838,30 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
     	exit( 1 );
     }
 
+#ifdef LINUX
+	if (prefetch)
+		startPrefetch();
+#endif
+
 	handleVMArgs(&vmArgs);
+	MARK_PHASE("config");
 
-    launchMode = determineVM(&msg);
-    if (launchMode == -1) {
+#ifndef _WIN32
+	/* don't create a VM only for Equinox to find the workspace in use */
+	checkWorkspaceLock(argc, argv, vmArgs);
+#endif
+#ifdef LINUX
+	startDiscovery(context);
+#endif
+#ifdef HEADLESS
+    context->launchMode = determineJavaExe(context, &msg);
+#else
+    context->launchMode = determineVM(context, &msg);
+#endif
+#ifdef LINUX
+	joinDiscovery();
+#endif
+    if (context->launchMode == -1) {
     	/* problem */
     	errorMsg = malloc((_tcslen(noVMMsg) + _tcslen(officialName) + _tcslen(msg) + 1) * sizeof(_TCHAR));
     	_stprintf( errorMsg, noVMMsg, officialName, msg );
@@ -602,10 +873,14 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
     	free( msg );
     	exit(1);
 	}
+	MARK_PHASE("vm");
 
 	/* Find the startup.jar */
-	jarFile = findStartupJar();
-	if(jarFile == NULL) {
+#ifndef LINUX
+	context->jarFile = findStartupJar(context);
+#endif
+	frameworkLocation = context->frameworkLocation;
+	if(context->jarFile == NULL) {
 		errorMsg = malloc( (_tcslen(startupMsg) + _tcslen(officialName) + 10) * sizeof(_TCHAR) );
         _stprintf( errorMsg, startupMsg, officialName );
         if (!suppressErrors)
@@ -615,24 +890,56 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
         free( errorMsg );
     	exit( 1 );
 	}
+	MARK_PHASE("jar");
+
+#ifdef LINUX
+	if (buildRuntimeDir != NULL)
+		return createRuntime(context);
+#endif
 
 #ifdef _WIN32
-	if( launchMode == LAUNCH_JNI && (debug || needConsole) ) {
+	if( context->launchMode == LAUNCH_JNI && (debug || needConsole) ) {
 		createConsole();
 	}
 #endif
 
-    /* If the showsplash option was given and we are using JNI */
+#ifdef LINUX
+	if (checkpointDir != NULL || restoreDir != NULL)
+		context->launchMode = prepareCheckpoint(context);
+	if (prefetch)
+		prefetchStartupFiles(context);
+	/* perf and the output relay need a java process of their own */
+	if (perfRecord && context->javaVM == NULL) {
+		_ftprintf(stderr, execMsg, PERF_RECORD);
+		perfRecord = 0;
+	}
+	if (logToFile != NULL && context->javaVM == NULL) {
+		_ftprintf(stderr, execMsg, LOG_TO);
+		logToFile = NULL;
+	}
+	if (perfRecord || logToFile != NULL)
+		context->launchMode = LAUNCH_EXE;
+	if (cgroupSpec != NULL)
+		startCgroup();
+	/* a checkpointed VM can't keep the channel open */
+	if (context->launchMode == LAUNCH_EXE && checkpointDir == NULL && restoreDir == NULL)
+		startControl(context);
+	startHandoff(context);
+#endif
+
+    /* If the showsplash option was given and we are using JNI, or the exec'd VM can drive the splash */
     if (!noSplash && showSplashArg)
     {
+#ifndef LINUX
     	splashBitmap = findSplash(showSplashArg);
-    	if (splashBitmap != NULL && launchMode == LAUNCH_JNI) {
+#endif
+    	if (splashBitmap != NULL && (context->launchMode == LAUNCH_JNI || context->controlProp != NULL)) {
 	    	showSplash(splashBitmap);
     	}
     }
 
     /* not using JNI launching, need some shared data */
-    if (launchMode == LAUNCH_EXE && createSharedData( &sharedID, MAX_SHARED_LENGTH )) {
+    if (context->launchMode == LAUNCH_EXE && createSharedData( &context->sharedID, MAX_SHARED_LENGTH )) {
         if (debug) {
         	if (!suppressErrors)
         		displayMessage( officialName, shareMsg );
@@ -651,39 +958,67 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
     }
 #endif
 #endif
-	/* the startup jarFile goes on the classpath */
-    if (launchMode == LAUNCH_JNI) {
-    	/* JNI launching, classpath is set using -Djava.class.path */
-		cp = malloc((_tcslen(CLASSPATH_PREFIX) + _tcslen(jarFile) + 1) * sizeof(_TCHAR));
-		cp = _tcscpy(cp, CLASSPATH_PREFIX);
-		_tcscat(cp, jarFile);
-    } else {
-    	/* exec java, jar is specified with -jar */
-    	cp = JAR;
-    	cpValue = malloc((_tcslen(jarFile) + 1) * sizeof(_TCHAR));
-    	_tcscpy(cpValue, jarFile);
+    MARK_PHASE("display");
+
+#ifdef LINUX
+    if (profileStartup)
+    	prepareStartupProfile(context);
+    if (perf || perfRecord) {
+    	context->diagnosticArg = UNLOCK_DIAGNOSTIC;
+    	context->perfMapArg = DUMP_PERF_MAP;
+    	context->framePointerArg = PRESERVE_FRAME_POINTER;
     }
+    /* only a VM in this process can be asked for its summary */
+    if (memReport && context->launchMode == LAUNCH_JNI)
+    	context->nmtArg = NMT_SUMMARY;
+#endif
 
     /* Get the command to start the Java VM. */
-    userVMarg = vmArgs;
-    getVMCommand( launchMode, argc, argv, &vmCommandArgs, &progCommandArgs );
-
-    if (launchMode == LAUNCH_EXE) {
-    	vmCommand = buildLaunchCommand(javaVM, vmCommandArgs, progCommandArgs);
+    context->argc = argc;
+    context->argv = argv;
+    context->userVMarg = vmArgs;
+    context->noSplash = noSplash;
+    buildVMCommand( context );
+
+#ifdef LINUX
+    if (restoring) {
+    	free(context->vmCommand);
+    	context->vmCommand = buildRestoreCommand(context);
     }
+    if (perfRecord)
+    	context->vmCommand = buildPerfCommand(context);
+#endif
 
     /* While the Java VM should be restarted */
     while(running)
     {
-		msg = formatVmCommandMsg( vmCommand, vmCommandArgs, progCommandArgs );
+		msg = formatVmCommandMsg( context->vmCommand, context->vmCommandArgs, context->progCommandArgs );
 		if (debug) _tprintf( goVMMsg, msg );
 
-		if(launchMode == LAUNCH_JNI) {
-			javaResults = startJavaVM(jniLib, vmCommandArgs, progCommandArgs, jarFile);
+#ifdef LINUX
+		/* the VM starts once the launchers ahead of this one are done starting theirs */
+		if (maxStartsString != NULL)
+			waitForStartSlot();
+		if (stallDumpString != NULL)
+			startStallDump(context);
+		if (logToFile != NULL)
+			startLog();
+		targetLauncherVars(context);
+#endif
+
+		if(context->launchMode == LAUNCH_JNI) {
+			javaResults = startJavaVM(context->jniLib, context->vmCommandArgs, context->progCommandArgs, context->jarFile);
 		} else {
-			javaResults = launchJavaVM(vmCommand);
+			javaResults = launchJavaVM(context->vmCommand);
 		}
 
+#ifdef LINUX
+		stopStallMonitor();
+		startupFd = -1;
+		stopLogRelay();
+		releaseStartSlot();
+#endif
+
 		if (javaResults == NULL) {
 			/* shouldn't happen, but just in case */
 			javaResults = malloc(sizeof(JavaResults));
@@ -692,12 +1027,28 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 			javaResults->errorMessage = _tcsdup(javaFailureMsg);
 		}
 
+#ifdef LINUX
+		/* the VM is gone after writing its checkpoint, continue from the image */
+		if (checkpointImage != NULL && !restoring && completeCheckpoint(checkpointImage)) {
+			if (debug) _tprintf( _T_ECLIPSE("Restore VM from %s\n"), checkpointImage );
+			restoring = 1;
+			free( context->vmCommand );
+			context->vmCommand = buildRestoreCommand(context);
+			free( javaResults );
+			free( msg );
+			continue;
+		}
+#endif
+
 	    switch( javaResults->launchResult + javaResults->runResult ) {
 	        case 0: /* normal exit */
 	        	running = 0;
 	            break;
 	        case RESTART_LAST_EC:
-	        	if (launchMode == LAUNCH_JNI) {
+#ifdef LINUX
+	        	dropCheckpoint(context);
+#endif
+	        	if (context->launchMode == LAUNCH_JNI) {
 		        	/* copy for relaunch, +1 to ensure NULL terminated */
 		        	relaunchCommand = malloc((initialArgc + 1) * sizeof(_TCHAR*));
 		        	memcpy(relaunchCommand, initialArgv, (initialArgc + 1) * sizeof(_TCHAR*));
@@ -708,16 +1059,20 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 	        	break;
 
 	        case RESTART_NEW_EC:
-	        	if(launchMode == LAUNCH_EXE) {
-	        		if (exitData != NULL) free(exitData);
-	        		if (getSharedData( sharedID, &exitData ) != 0)
-	        			exitData = NULL;
-	        	}
+	        	if(context->launchMode == LAUNCH_EXE)
+	        		readExecExitData(context);
+#ifdef LINUX
+	        	dropCheckpoint(context);
+#endif
 	            if (exitData != 0) {
-	            	if (vmCommand != NULL) free( vmCommand );
-	                vmCommand = parseArgList( exitData );
-	                if (launchMode == LAUNCH_JNI) {
-	                	relaunchCommand = getRelaunchCommand(vmCommand);
+	            	if (context->vmCommand != NULL) free( context->vmCommand );
+	                context->vmCommand = parseArgList( exitData );
+#ifdef LINUX
+	                /* eclipse.vmargs are those of the VM that was asked to checkpoint */
+	                removeCheckpointArgs(context->vmCommand);
+#endif
+	                if (context->launchMode == LAUNCH_JNI) {
+	                	relaunchCommand = getRelaunchCommand(context, context->vmCommand);
 	                	running = 0;
 	                }
 	            } else {
@@ -734,11 +1089,8 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 				_TCHAR *title = _tcsdup(officialName);
 	            running = 0;
 	            errorMsg = NULL;
-	            if (launchMode == LAUNCH_EXE) {
-	            	if (exitData != NULL) free(exitData);
-	        		if (getSharedData( sharedID, &exitData ) != 0)
-	        			exitData = NULL;
-	        	}
+	            if (context->launchMode == LAUNCH_EXE)
+	            	readExecExitData(context);
 	            if (exitData != 0) {
 	            	errorMsg = exitData;
 	            	exitData = NULL;
@@ -793,30 +1145,64 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
 	    free( msg );
     }
 
+#ifdef LINUX
+    /* the instance is done, new launchers start their own */
+    stopHandoff();
+    if (perfData != NULL && perfProgram != NULL)
+    	_ftprintf(stderr, perfDataMsg, perfData);
+    if (cgroupSpec != NULL)
+    	reportPressure();
+    if (memReport) {
+    	/* an exec'd VM has been waited for */
+    	reportMemory(context, "exit", context->launchMode == LAUNCH_JNI ? getpid() : 0);
+    	if (memReportFile != NULL)
+    		_ftprintf(stderr, memReportMsg, memReportFile);
+    }
+#endif
+
     if(relaunchCommand != NULL)
     	restartLauncher(NULL, relaunchCommand);
 
-    if (launchMode == LAUNCH_JNI)
+    if (context->launchMode == LAUNCH_JNI) {
+    	if (fastExitString != NULL)
+    		_stscanf(fastExitString, _T_ECLIPSE("%d"), &fastExitTimeout);
     	cleanupVM(javaResults->launchResult ? javaResults->launchResult : javaResults->runResult);
+    }
 
-    if (sharedID != NULL) {
-    	destroySharedData( sharedID );
-    	free( sharedID );
+    if (context->sharedID != NULL) {
+    	destroySharedData( context->sharedID );
+    	free( context->sharedID );
     }
 
     /* Cleanup time. */
-    free( vmCommandArgs );
-    free( progCommandArgs );
-    free( jarFile );
+    free( context->vmCommandArgs );
+    free( context->progCommandArgs );
+    free( context->jarFile );
     free( programDir );
     free( program );
     free( officialName );
-    if(vmCommand != NULL)	 	 free(vmCommand);
-    if(launchMode == LAUNCH_JNI) free(cp);
-    if(cpValue != NULL)		 	 free(cpValue);
+    if(context->vmCommand != NULL)	free(context->vmCommand);
+    if(context->launchMode == LAUNCH_JNI) free(context->cp);
+    if(context->cpValue != NULL)	free(context->cpValue);
     if(exitData != NULL)		 free(exitData);
     if(splashBitmap != NULL)  	 free(splashBitmap);
     if(vmArgs != NULL)			 free(vmArgs);
+    if(context->checkpointArg != NULL)	free(context->checkpointArg);
+    if(context->frameworkProp != NULL)	free(context->frameworkProp);
+    if(context->controlProp != NULL)	free(context->controlProp);
+    if(context->controlFilesProp != NULL)	free(context->controlFilesProp);
+    if(context->recordingArg != NULL)	free(context->recordingArg);
+    if(context->phasesProp != NULL)	free(context->phasesProp);
+    if(context->frameworkLocation != NULL)	free(context->frameworkLocation);
+#ifdef LINUX
+    if(checkpointImage != NULL)	 free(checkpointImage);
+    if(restoreArg != NULL)		 free(restoreArg);
+    if(restoreExitDataArg != NULL) free(restoreExitDataArg);
+    if(handoffSocket != NULL)	 free(handoffSocket);
+    if(perfProgram != NULL)		 free(perfProgram);
+    if(perfData != NULL)		 free(perfData);
+    stopControlChannel();
+#endif
 
     if (javaResults == NULL)
     	return -1;
@@ -827,6 +1213,18 @@ static int _run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[])
     return running;
 }
 
+/* Get the exit data of an exec'd VM, from its control channel or the shared memory */
+static void readExecExitData( LaunchContext* context ) {
+	if (exitData != NULL) free(exitData);
+	exitData = NULL;
+#ifdef LINUX
+	if ((exitData = takeControlExitData()) != NULL)
+		return;
+#endif
+	if (getSharedData( context->sharedID, &exitData ) != 0)
+		exitData = NULL;
+}
+
 static _TCHAR** buildLaunchCommand( _TCHAR* program, _TCHAR** vmArgs, _TCHAR** progArgs ) {
 	int nVM = -1, nProg = -1;
 	_TCHAR** result;
@@ -842,6 +1240,928 @@ static _TCHAR** buildLaunchCommand( _TCHAR* program, _TCHAR** vmArgs, _TCHAR** p
 	return result;
 }
 
+/* Build the VM and program arguments, and the command to exec for LAUNCH_EXE,
+ * once the VM and the startup jar are known.
+ */
+static void buildVMCommand( LaunchContext* context ) {
+	/* the startup jarFile goes on the classpath */
+    if (context->launchMode == LAUNCH_JNI) {
+    	/* JNI launching, classpath is set using -Djava.class.path */
+		context->cp = malloc((_tcslen(CLASSPATH_PREFIX) + _tcslen(context->jarFile) + 1) * sizeof(_TCHAR));
+		context->cp = _tcscpy(context->cp, CLASSPATH_PREFIX);
+		_tcscat(context->cp, context->jarFile);
+    } else {
+    	/* exec java, jar is specified with -jar */
+    	context->cp = JAR;
+    	context->cpValue = malloc((_tcslen(context->jarFile) + 1) * sizeof(_TCHAR));
+    	_tcscpy(context->cpValue, context->jarFile);
+    	/* JNI launching hands the framework over through the JNIBridge */
+    	if (context->frameworkLocation != NULL) {
+    		context->frameworkProp = malloc((_tcslen(FRAMEWORK_PROP) + _tcslen(context->frameworkLocation) + 1) * sizeof(_TCHAR));
+    		_stprintf(context->frameworkProp, _T_ECLIPSE("%s%s"), FRAMEWORK_PROP, context->frameworkLocation);
+    	}
+    }
+
+    getVMCommand( context, &context->vmCommandArgs, &context->progCommandArgs );
+
+    if (context->launchMode == LAUNCH_EXE)
+    	context->vmCommand = buildLaunchCommand(context->javaVM, context->vmCommandArgs, context->progCommandArgs);
+}
+
+#if !defined(_WIN32) && !defined(MACOSX)
+#include <pthread.h>
+
+/* Embedding API, see eclipseLaunch.h.  Preparing and resolving a launch use process wide
+ * state (the option table, the directory index of findFile, eeLibPath), so they are
+ * serialized.  Starting and waiting for the VMs is not.
+ */
+static pthread_mutex_t launchLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Determine the VM for launches that can not host it in this process (the embedding API,
+ * the static headless launcher): only a java executable will do.
+ */
+static int determineJavaExe(LaunchContext* context, _TCHAR** msg) {
+	if (determineVM(context, msg) == -1)
+		return -1;
+	if (context->javaVM == NULL) {
+		*msg = malloc((_tcslen(vmExeMsg) + _tcslen(context->jniLib) + 1) * sizeof(_TCHAR));
+		_stprintf(*msg, vmExeMsg, context->jniLib);
+		return -1;
+	}
+	if (context->jniLib != NULL && context->jniLib != context->javaVM)
+		free(context->jniLib);
+	context->jniLib = NULL;
+	return LAUNCH_EXE;
+}
+
+LaunchContext* prepareLaunch(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]) {
+	LaunchContext* context = malloc(sizeof(LaunchContext));
+	memset(context, 0, sizeof(LaunchContext));
+
+	pthread_mutex_lock(&launchLock);
+	if (program == NULL) {
+		/* not started by the eclipse executable, argv[0] tells us the installation */
+		program = _tcsdup(argv[0]);
+		programDir = getProgramDir();
+	}
+	if (officialName == NULL)
+		officialName = getDefaultOfficialName();
+
+	context->argv = malloc((argc + 1) * sizeof(_TCHAR*));
+	memcpy(context->argv, argv, argc * sizeof(_TCHAR*));
+	context->argv[argc] = NULL;
+	context->argc = argc;
+	parseArgs(context, &context->argc, context->argv);
+
+	/* this always allocates new memory */
+	handleVMArgs(&vmArgs);
+	context->userVMarg = vmArgs;
+	context->noSplash = 1;
+	pthread_mutex_unlock(&launchLock);
+	return context;
+}
+
+int resolveLaunch(LaunchContext* context, _TCHAR** msg) {
+	int result = -1;
+
+	*msg = NULL;
+	pthread_mutex_lock(&launchLock);
+	/* there is only one VM per process, all others are exec'd */
+	context->launchMode = determineJavaExe(context, msg);
+	if (context->launchMode != -1) {
+		context->jarFile = findStartupJar(context);
+		if (context->jarFile == NULL) {
+			*msg = malloc((_tcslen(startupMsg) + _tcslen(officialName) + 10) * sizeof(_TCHAR));
+			_stprintf(*msg, startupMsg, officialName);
+		} else {
+			if (createSharedData(&context->sharedID, MAX_SHARED_LENGTH) != 0)
+				context->sharedID = NULL;
+			buildVMCommand(context);
+			result = 0;
+		}
+	}
+	pthread_mutex_unlock(&launchLock);
+	return result;
+}
+
+_TCHAR** getLaunchCommand(LaunchContext* context) {
+	return context->vmCommand;
+}
+
+int launchJavaExe(LaunchContext* context) {
+	if (context->vmCommand == NULL || context->process > 0)
+		return -1;
+	if (debug) {
+		_TCHAR* msg = formatVmCommandMsg(context->vmCommand, NULL, NULL);
+		_tprintf(goVMMsg, msg);
+		free(msg);
+	}
+	context->process = spawnJavaProcess(context->vmCommand);
+	if (context->process < 0) {
+		context->process = 0;
+		return -1;
+	}
+	return context->process;
+}
+
+int waitForLaunch(LaunchContext* context, _TCHAR** exitData) {
+	int exitCode;
+
+	if (exitData != NULL)
+		*exitData = NULL;
+	if (context->process <= 0)
+		return -1;
+	exitCode = waitJavaProcess(context->process);
+	context->process = 0;
+
+	if (exitData != NULL && context->sharedID != NULL) {
+		if (getSharedData(context->sharedID, exitData) != 0)
+			*exitData = NULL;
+	}
+	return exitCode;
+}
+
+void freeLaunch(LaunchContext* context) {
+	if (context->sharedID != NULL) {
+		destroySharedData(context->sharedID);
+		free(context->sharedID);
+	}
+	if (context->vmCommand != NULL)			free(context->vmCommand);
+	if (context->vmCommandArgs != NULL)		free(context->vmCommandArgs);
+	if (context->progCommandArgs != NULL)	free(context->progCommandArgs);
+	if (context->cpValue != NULL)			free(context->cpValue);
+	if (context->frameworkProp != NULL)		free(context->frameworkProp);
+	if (context->frameworkLocation != NULL)	free(context->frameworkLocation);
+	if (context->jarFile != NULL)			free(context->jarFile);
+	if (context->javaVM != NULL)			free(context->javaVM);
+	if (context->userVMarg != NULL)			free(context->userVMarg);
+	if (context->eeExecutable != NULL)		free(context->eeExecutable);
+	if (context->eeConsole != NULL)			free(context->eeConsole);
+	if (context->eeLibrary != NULL)			free(context->eeLibrary);
+	if (context->eeLibPath != NULL) {
+		/* findVMLibrary looks at the global, see processEEProps */
+		pthread_mutex_lock(&launchLock);
+		if (eeLibPath == context->eeLibPath)
+			eeLibPath = NULL;
+		pthread_mutex_unlock(&launchLock);
+		free(context->eeLibPath);
+	}
+	freeConfig(context->eeVMarg);
+	free(context->argv);
+	free(context);
+}
+#endif
+
+#ifdef LINUX
+/* Prefetch what the previous startup used */
+static void startPrefetch() {
+	_TCHAR* none[] = { NULL };
+
+	prefetchRecord = getPrefetchRecord(programDir);
+	if (prefetchRecord != NULL)
+		prefetchFiles(none, prefetchRecord);
+}
+
+/* Prefetch the files we now know the VM will need, and have the Java side record this
+ * startup for the next one.  The recording process is identified by pid and launch mode,
+ * so that an eclipse started from this eclipse does not overwrite the record.
+ */
+static void prefetchStartupFiles(LaunchContext* context) {
+	_TCHAR* paths[8];
+	_TCHAR* javaHome = NULL;
+	_TCHAR* ch;
+	int count = 0;
+
+	if (context->launchMode == LAUNCH_JNI && context->jniLib != NULL)
+		paths[count++] = context->jniLib;
+	if (context->javaVM != NULL) {
+		/* <java home>/bin/java */
+		javaHome = resolveSymlinks(context->javaVM);
+		if (javaHome == context->javaVM)
+			javaHome = _tcsdup(context->javaVM);
+		if ((ch = lastDirSeparator(javaHome)) != NULL) {
+			*ch = 0;
+			if ((ch = lastDirSeparator(javaHome)) != NULL) {
+				*ch = 0;
+				ch = malloc((_tcslen(javaHome) + 32) * sizeof(_TCHAR));
+				_stprintf(ch, _T_ECLIPSE("%s/lib/modules"), javaHome);
+				paths[count++] = ch;
+				ch = malloc((_tcslen(javaHome) + 32) * sizeof(_TCHAR));
+				_stprintf(ch, _T_ECLIPSE("%s/lib/server/libjvm.so"), javaHome);
+				paths[count++] = ch;
+				ch = malloc((_tcslen(javaHome) + 32) * sizeof(_TCHAR));
+				_stprintf(ch, _T_ECLIPSE("%s/lib/server/classes.jsa"), javaHome);
+				paths[count++] = ch;
+			}
+		}
+	}
+	paths[count++] = context->jarFile;
+	if (context->frameworkLocation != NULL)
+		paths[count++] = context->frameworkLocation;
+	paths[count] = NULL;
+
+	prefetchFiles(paths, NULL);
+
+	if (prefetchRecord != NULL) {
+		setLauncherVar(PREFETCH_RECORD_VAR, prefetchRecord);
+		free(prefetchRecord);
+		prefetchRecord = NULL;
+	}
+
+	while (--count >= 0) {
+		if (paths[count] != context->jniLib && paths[count] != context->jarFile && paths[count] != context->frameworkLocation)
+			free(paths[count]);
+	}
+	if (javaHome != NULL)
+		free(javaHome);
+}
+
+static const char* launcherVars[] = { STARTUP_FD_VAR, PREFETCH_RECORD_VAR, PROFILE_RECORDING_VAR, NULL };
+
+/* Pass a value to startupComplete(), which runs in the launcher (JNI) or in the java it
+ * exec'd: <launcher pid>:<J|E|W>:<value>, the mode is set by targetLauncherVars()
+ */
+static void setLauncherVar(const char* name, _TCHAR* value) {
+	_TCHAR* ch = malloc((_tcslen(value) + 32) * sizeof(_TCHAR));
+	_stprintf(ch, _T_ECLIPSE("%d:J:%s"), (int) getpid(), value);
+	setenv(name, ch, 1);
+	free(ch);
+}
+
+/* Address the values of setLauncherVar() to the VM about to start, once it is known how it
+ * starts: in this process (J), as the java this process execs (E), or as the java that
+ * perf record execs for it (W).
+ */
+static void targetLauncherVars(LaunchContext* context) {
+	_TCHAR mode = _T_ECLIPSE('J');
+	_TCHAR* value;
+	_TCHAR* ch;
+	int i, offset;
+
+	if (context->launchMode == LAUNCH_EXE)
+		mode = (perfProgram != NULL && context->vmCommand[0] == perfProgram) ? _T_ECLIPSE('W') : _T_ECLIPSE('E');
+	for (i = 0; launcherVars[i] != NULL; i++) {
+		value = getenv(launcherVars[i]);
+		ch = (value != NULL) ? _tcschr(value, _T_ECLIPSE(':')) : NULL;
+		if (ch == NULL || ch[1] == 0 || ch[1] == mode)
+			continue;
+		offset = ch - value + 1;
+		value = _tcsdup(value);
+		value[offset] = mode;
+		setenv(launcherVars[i], value, 1);
+		free(value);
+	}
+}
+
+/* The parent of process pid, -1 if unknown */
+static int getParentProcess(int pid) {
+	_TCHAR path[32];
+	_TCHAR line[512];
+	_TCHAR* ch = NULL;
+	FILE* file;
+	int parent = -1;
+
+	_stprintf(path, _T_ECLIPSE("/proc/%d/stat"), pid);
+	if ((file = fopen(path, "r")) == NULL)
+		return -1;
+	/* pid (comm) state ppid ..., the command may contain spaces and parentheses */
+	if (fgets(line, sizeof(line), file) != NULL)
+		ch = _tcsrchr(line, _T_ECLIPSE(')'));
+	if (ch == NULL || _stscanf(ch + 1, _T_ECLIPSE(" %*c %d"), &parent) != 1)
+		parent = -1;
+	fclose(file);
+	return parent;
+}
+
+/* The value set with setLauncherVar() if it is meant for this process, not for
+ * one started by Java.  The variable is removed.
+ */
+static _TCHAR* getLauncherVar(const char* name) {
+	_TCHAR* result = NULL;
+	_TCHAR* value = getenv(name);
+	_TCHAR* mode = (value != NULL) ? _tcschr(value, _T_ECLIPSE(':')) : NULL;
+	if (mode != NULL && mode[1] != 0 && mode[2] == _T_ECLIPSE(':')) {
+		/* we are either the launcher itself (JNI) or the java it started, maybe through perf */
+		int pid = atoi(value);
+		int target;
+		switch (mode[1]) {
+			case _T_ECLIPSE('J'): target = getpid(); break;
+			case _T_ECLIPSE('W'): target = getParentProcess(getppid()); break;
+			default:              target = getppid(); break;
+		}
+		if (pid == target)
+			result = _tcsdup(mode + 3);
+		unsetenv(name);
+	}
+	return result;
+}
+
+/* The VM runs in this process for the rest of the session, give back what only the
+ * startup needed: the command line (the VM has its own copies), the splash, the
+ * findFile directory index, the window system libraries and the free pages of the
+ * native heap.  The ini arguments stay, argv points into them until run() returns,
+ * and so does GTK once a splash initialized it, see releaseWindowSystem.
+ */
+static void reclaimStartupMemory(LaunchContext* context) {
+	long before = getResidentMemory();
+
+	/* the VM is restored from the image after a checkpoint, it needs the command */
+	if (checkpointImage == NULL) {
+		free(context->vmCommandArgs);
+		free(context->progCommandArgs);
+		context->vmCommandArgs = NULL;
+		context->progCommandArgs = NULL;
+		freeConfig(context->eeVMarg);
+		context->eeVMarg = NULL;
+		context->nEEargs = 0;
+		free(splashBitmap);
+		splashBitmap = NULL;
+	}
+	freeFileIndex();
+	releaseWindowSystem();
+	malloc_trim(0);
+	if (debug)
+		_tprintf(_T_ECLIPSE("Startup complete, resident memory %ldkB, was %ldkB\n"), getResidentMemory(), before);
+}
+
+static int getVMProcess() {
+	return defaultContext.launchMode == LAUNCH_JNI ? getpid() : javaProcess;
+}
+
+/* Sample the VM with thread dumps if it takes longer than --launcher.stallDump to start */
+static void startStallDump(LaunchContext* context) {
+	_TCHAR fd[16];
+	_TCHAR* dumpFile = getStallDumpFile();
+	int seconds = 0;
+
+	_stscanf(stallDumpString, _T_ECLIPSE("%d"), &seconds);
+	if (dumpFile == NULL || seconds <= 0) {
+		free(dumpFile);
+		return;
+	}
+	startupFd = startStallMonitor(seconds, dumpFile, getVMProcess);
+	_stprintf(fd, _T_ECLIPSE("%d"), startupFd);
+	if (debug) _tprintf(_T_ECLIPSE("Thread dumps of a stalled startup go to %s\n"), dumpFile);
+	if (startupFd >= 0)
+		setLauncherVar(STARTUP_FD_VAR, fd);
+	free(dumpFile);
+}
+
+/* Record the startup of the VM with JFR, until Java takes down the splash screen
+ * (see takedown_splash in eclipseJNI.c) or for --launcher.profileDuration seconds.
+ */
+static void prepareStartupProfile(LaunchContext* context) {
+	_TCHAR* recordingFile = getLauncherCacheFile("startup", ".jfr");
+	_TCHAR* timings;
+	int seconds = 0;
+
+	if (recordingFile == NULL)
+		return;
+	if (profileDurationString != NULL)
+		_stscanf(profileDurationString, _T_ECLIPSE("%d"), &seconds);
+
+	context->recordingArg = malloc((_tcslen(START_RECORDING) + _tcslen(recordingFile) + 128) * sizeof(_TCHAR));
+	_stprintf(context->recordingArg, _T_ECLIPSE("%sname=%s,settings=profile,dumponexit=true,filename=%s"), START_RECORDING, STARTUP_RECORDING, recordingFile);
+	if (seconds > 0)
+		_stprintf(context->recordingArg + _tcslen(context->recordingArg), _T_ECLIPSE(",duration=%ds"), seconds);
+	else
+		setLauncherVar(PROFILE_RECORDING_VAR, STARTUP_RECORDING);
+
+	markPhase("launch");
+	timings = getPhaseTimings();
+	context->phasesProp = malloc((_tcslen(PHASES_PROP) + _tcslen(timings) + 1) * sizeof(_TCHAR));
+	_stprintf(context->phasesProp, _T_ECLIPSE("%s%s"), PHASES_PROP, timings);
+	if (debug) _tprintf(_T_ECLIPSE("Recording the startup to %s\nLauncher phases (ms): %s\n"), recordingFile, timings);
+	free(timings);
+	free(recordingFile);
+}
+
+/* Run the exec'd VM under perf record, call graphs follow the frame pointers kept
+ * for --launcher.perf.  The old command is freed.
+ */
+static _TCHAR** buildPerfCommand(LaunchContext* context) {
+	_TCHAR** result;
+	int count = 0, dst = 0, src;
+
+	if (perfProgram == NULL)
+		perfProgram = findCommand(_T_ECLIPSE("perf"));
+	if (perfData == NULL)
+		perfData = getLauncherCacheFile("perf", ".data");
+	if (perfProgram == NULL || perfData == NULL) {
+		_ftprintf(stderr, perfMsg);
+		return context->vmCommand;
+	}
+
+	while (context->vmCommand[count] != NULL)
+		count++;
+	result = malloc((count + 7) * sizeof(_TCHAR*));
+	result[dst++] = perfProgram;
+	result[dst++] = _T_ECLIPSE("record");
+	result[dst++] = _T_ECLIPSE("-g");
+	result[dst++] = _T_ECLIPSE("-o");
+	result[dst++] = perfData;
+	result[dst++] = _T_ECLIPSE("--");
+	for (src = 0; src < count; src++)
+		result[dst++] = context->vmCommand[src];
+	result[dst] = NULL;
+	free(context->vmCommand);
+	return result;
+}
+
+/* Relay the output of the exec'd VM to --launcher.logTo, rotated at --launcher.logMaxSize
+ * (bytes, or with a k, m or g suffix like -Xss)
+ */
+static void startLog() {
+	long maxSize = 10 * 1024 * 1024;
+	_TCHAR unit = 0;
+
+	if (logMaxSizeString != NULL && _stscanf(logMaxSizeString, _T_ECLIPSE("%ld%c"), &maxSize, &unit) > 0) {
+		switch (unit) {
+			case 'g': case 'G': maxSize *= 1024; /* fall through */
+			case 'm': case 'M': maxSize *= 1024; /* fall through */
+			case 'k': case 'K': maxSize *= 1024;
+		}
+	}
+	if (startLogRelay(logToFile, maxSize, logTimestamps) != 0)
+		_ftprintf(stderr, logToMsg, logToFile);
+}
+
+/* Run the VM in a cgroup of its own with the --launcher.cgroup settings, the
+ * launcher goes along so a VM started through JNI or exec'd ends up there alike.
+ */
+static void startCgroup() {
+	char* msg = NULL;
+
+	if (joinCgroup(cgroupSpec, &msg) != 0) {
+		_ftprintf(stderr, cgroupMsg, CGROUP, msg);
+		free(msg);
+	}
+}
+
+/* Let the exec'd VM drive the splash and return its exit data through a pipe, see eclipseControl.c */
+static void startControl(LaunchContext* context) {
+	char* path;
+
+	if (startControlChannel() != 0)
+		return;
+	path = getControlPath();
+	context->controlProp = malloc((_tcslen(CONTROL_PROP) + _tcslen(path) + 1) * sizeof(_TCHAR));
+	_stprintf(context->controlProp, _T_ECLIPSE("%s%s"), CONTROL_PROP, path);
+	if ((path = getControlFilesPath()) != NULL) {
+		context->controlFilesProp = malloc((_tcslen(CONTROL_FILES_PROP) + _tcslen(path) + 1) * sizeof(_TCHAR));
+		_stprintf(context->controlFilesProp, _T_ECLIPSE("%s%s"), CONTROL_FILES_PROP, path);
+	}
+}
+
+/* Pass the files another launcher handed over to SWT, or to a VM that reads them from
+ * the control channel.  Runs on the handoff thread.
+ */
+static int openHandedOffFiles(_TCHAR* files[]) {
+	return forwardFileOpen(files) || sendControlFiles(files);
+}
+
+/* Listen for the files other launchers hand over only if this instance opens files
+ * (it was started with some, or the product makes them the default action), and can
+ * pass them on: a GTK launcher through SWT's GDBus service, the headless launcher only
+ * through the control channel.
+ */
+static void startHandoff(LaunchContext* context) {
+	int opensFiles = (filePath != NULL && filePath[0] != NULL)
+		|| (defaultAction != NULL && _tcsicmp(defaultAction, ACTION_OPENFILE) == 0);
+
+	if (handoffSocket == NULL || !opensFiles)
+		return;
+#ifdef HEADLESS
+	if (context->controlFilesProp == NULL)
+		return;
+#endif
+	listenForHandoff(handoffSocket, openHandedOffFiles);
+}
+
+/*
+ * The startup jar, the splash and the window system libraries don't depend on the VM,
+ * so they are looked for on threads of their own while the main thread determines the
+ * VM.  Each task has its own result, the errors are reported after joinDiscovery in the
+ * order they were reported in before.  A task that can't get a thread runs inline.
+ */
+static pthread_t discoveryThreads[3];
+static int       discoveryCount = 0;
+
+static void* discoverStartupJar(void* context) {
+	((LaunchContext*) context)->jarFile = findStartupJar((LaunchContext*) context);
+	return NULL;
+}
+
+static void* discoverSplash(void* arg) {
+	splashBitmap = findSplash(showSplashArg);
+	return NULL;
+}
+
+#ifndef HEADLESS
+static void* discoverWindowSystem(void* arg) {
+	preloadWindowSystem();
+	return NULL;
+}
+#endif
+
+static void startTask(void* (*task)(void*), void* arg) {
+	if (pthread_create(&discoveryThreads[discoveryCount], NULL, task, arg) == 0)
+		discoveryCount++;
+	else
+		task(arg);
+}
+
+static void startDiscovery(LaunchContext* context) {
+	startTask(discoverStartupJar, context);
+	if (!noSplash && showSplashArg)
+		startTask(discoverSplash, NULL);
+#ifndef HEADLESS
+	if (!suppressErrors && !noSplash && getenv("DISPLAY") != NULL)
+		startTask(discoverWindowSystem, NULL);
+#endif
+}
+
+static void joinDiscovery() {
+	while (discoveryCount > 0)
+		pthread_join(discoveryThreads[--discoveryCount], NULL);
+}
+
+/* Add a snapshot of the memory of the VM to the report of --launcher.memReport */
+static void reportMemory(LaunchContext* context, char* event, int process) {
+	_TCHAR* nmtSummary = NULL;
+
+	if (memReportFile == NULL && (memReportFile = getLauncherCacheFile("memory", ".json")) == NULL)
+		return;
+	if (process != 0 && context->launchMode == LAUNCH_JNI)
+		nmtSummary = getNativeMemorySummary();
+	writeMemoryReport(memReportFile, event, process, nmtSummary);
+	free(nmtSummary);
+}
+
+/* Wait in the queue of --launcher.maxConcurrentStarts, see eclipseAdmission.c */
+static void waitForStartSlot() {
+	int maxStarts = 0, timeout = 300;
+	long waited;
+
+	_stscanf(maxStartsString, _T_ECLIPSE("%d"), &maxStarts);
+	if (startQueueTimeoutString != NULL)
+		_stscanf(startQueueTimeoutString, _T_ECLIPSE("%d"), &timeout);
+	if (maxStarts <= 0)
+		return;
+	if (acquireStartSlot(maxStarts, timeout, &waited) == 0) {
+		if (debug) _tprintf(_T_ECLIPSE("Waited %ldms for one of %d concurrent starts\n"), waited, maxStarts);
+	} else if (waited > 0) {
+		_ftprintf(stderr, startQueueMsg, waited / 1000, maxStarts);
+	}
+	MARK_PHASE("queue");
+}
+
+/* Record how long the instance had to wait for CPU, memory and io */
+static void reportPressure() {
+	char* report = getLauncherCacheFile("cgroup", ".txt");
+
+	if (report != NULL && reportCgroup(report) == 0)
+		_ftprintf(stderr, cgroupDataMsg, report);
+	free(report);
+}
+
+/* Build the runtime for --launcher.buildRuntime from the selected JDK instead of launching */
+static int createRuntime(LaunchContext* context) {
+	_TCHAR* jars[] = { context->jarFile, context->frameworkLocation, NULL };
+	_TCHAR* vm = (context->javaVM != NULL) ? context->javaVM : context->jniLib;
+	_TCHAR* pluginsDir;
+	_TCHAR* msg = NULL;
+	int result;
+
+	pluginsDir = malloc((_tcslen(programDir) + _tcslen(_T_ECLIPSE("plugins")) + 1) * sizeof(_TCHAR));
+	_stprintf(pluginsDir, _T_ECLIPSE("%splugins"), programDir);
+	result = buildRuntime(vm, jars, pluginsDir, buildRuntimeDir, context->launchMode == LAUNCH_JNI, &msg);
+	if (result == 0) {
+		_tprintf(runtimeMsg, buildRuntimeDir, buildRuntimeDir);
+	} else {
+		_ftprintf(stderr, runtimeErrorMsg, buildRuntimeDir, msg);
+		free(msg);
+	}
+	free(pluginsDir);
+	return (result == 0) ? 0 : 1;
+}
+
+/* Pick the checkpoint image for this launch. CRaC restores into a new process,
+ * so this forces LAUNCH_EXE and turns off the splash screen, whose X connection
+ * could not be checkpointed anyway.
+ */
+static int prepareCheckpoint(LaunchContext* context) {
+	_TCHAR* dir = (restoreDir != NULL) ? restoreDir : checkpointDir;
+	_TCHAR* configFile;
+	_TCHAR* pluginsDir;
+
+	if (context->javaVM == NULL) {
+		if (debug) _tprintf( checkpointMsg, dir );
+		return context->launchMode;
+	}
+
+	/* a stamped ini changes the executable */
+	if (iniFile != NULL || embeddedIni != NULL)
+		configFile = (iniFile != NULL) ? iniFile : program;
+	else
+		configFile = getIniFile(program, consoleLauncher);
+	pluginsDir = malloc((_tcslen(programDir) + _tcslen(_T_ECLIPSE("plugins")) + 1) * sizeof(_TCHAR));
+	_stprintf(pluginsDir, _T_ECLIPSE("%splugins"), programDir);
+	checkpointImage = getCheckpointImage(dir, configFile, context->javaVM, pluginsDir, initialArgc, initialArgv);
+	if (configFile != iniFile && configFile != program)
+		free(configFile);
+	free(pluginsDir);
+
+	if (restoreDir != NULL && isCheckpointValid(checkpointImage)) {
+		restoring = 1;
+	} else if (resetCheckpoint(checkpointImage) == 0) {
+		context->checkpointArg = malloc((_tcslen(CRAC_CHECKPOINT) + _tcslen(checkpointImage) + 1) * sizeof(_TCHAR));
+		_stprintf(context->checkpointArg, _T_ECLIPSE("%s%s"), CRAC_CHECKPOINT, checkpointImage);
+		context->checkpointProp = CHECKPOINT_PROP;
+	} else {
+		if (debug) _tprintf( checkpointDirMsg, checkpointImage );
+		free(checkpointImage);
+		checkpointImage = NULL;
+		return context->launchMode;
+	}
+
+	noSplash = 1;
+	return LAUNCH_EXE;
+}
+
+/* The restored VM still has the arguments of the launch that made the checkpoint,
+ * pass it the exit data of this launch as a system property.
+ */
+static _TCHAR** buildRestoreCommand(LaunchContext* context) {
+	_TCHAR** result = malloc(4 * sizeof(_TCHAR*));
+	int dst = 0;
+
+	if (restoreArg == NULL) {
+		restoreArg = malloc((_tcslen(CRAC_RESTORE) + _tcslen(checkpointImage) + 1) * sizeof(_TCHAR));
+		_stprintf(restoreArg, _T_ECLIPSE("%s%s"), CRAC_RESTORE, checkpointImage);
+	}
+	if (restoreExitDataArg == NULL && context->sharedID != NULL) {
+		restoreExitDataArg = malloc((_tcslen(RESTORE_EXITDATA_PROP) + _tcslen(context->sharedID) + 1) * sizeof(_TCHAR));
+		_stprintf(restoreExitDataArg, _T_ECLIPSE("%s%s"), RESTORE_EXITDATA_PROP, context->sharedID);
+	}
+
+	result[dst++] = context->javaVM;
+	result[dst++] = restoreArg;
+	if (restoreExitDataArg != NULL)
+		result[dst++] = restoreExitDataArg;
+	result[dst] = NULL;
+	return result;
+}
+
+static int isCheckpointArg(_TCHAR* arg) {
+	return _tcsncmp(arg, CRAC_CHECKPOINT, _tcslen(CRAC_CHECKPOINT)) == 0 || _tcscmp(arg, CHECKPOINT_PROP) == 0
+		|| _tcsncmp(arg, CRAC_RESTORE, _tcslen(CRAC_RESTORE)) == 0
+		|| _tcsncmp(arg, RESTORE_EXITDATA_PROP, _tcslen(RESTORE_EXITDATA_PROP)) == 0;
+}
+
+static void removeCheckpointArgs(_TCHAR* args[]) {
+	int src, dst = 0;
+
+	for (src = 0; args != NULL && args[src] != NULL; src++) {
+		if (!isCheckpointArg(args[src]))
+			args[dst++] = args[src];
+	}
+	if (args != NULL)
+		args[dst] = NULL;
+}
+
+/* The VM asks for a restart after p2 installed something or to switch workspaces.  The image
+ * holds the VM from before, and a VM started with the checkpoint arguments would only write
+ * a new one and exit: invalidate the image and restart the VM the normal way.
+ */
+static void dropCheckpoint(LaunchContext* context) {
+	if (checkpointImage == NULL)
+		return;
+	if (debug) _tprintf( _T_ECLIPSE("Dropping checkpoint %s for the restart\n"), checkpointImage );
+	resetCheckpoint(checkpointImage);
+	free(checkpointImage);
+	checkpointImage = NULL;
+	restoring = 0;
+
+	/* the program arguments repeat them after -vmargs */
+	removeCheckpointArgs(context->vmCommandArgs);
+	removeCheckpointArgs(context->progCommandArgs);
+	if (context->checkpointArg != NULL)
+		free(context->checkpointArg);
+	context->checkpointArg = NULL;
+	context->checkpointProp = NULL;
+	if (context->launchMode == LAUNCH_EXE) {
+		free(context->vmCommand);
+		context->vmCommand = buildLaunchCommand(context->javaVM, context->vmCommandArgs, context->progCommandArgs);
+		if (perfRecord)
+			context->vmCommand = buildPerfCommand(context);
+	}
+}
+#endif
+
+#ifndef _WIN32
+/* The workspace given with -data or osgi.instance.area, resolved the way EquinoxLocations
+ * does, or NULL if none was given.
+ */
+static _TCHAR* getWorkspaceLocation(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]) {
+	_TCHAR* location = NULL;
+	_TCHAR* base = NULL;
+	_TCHAR* result;
+	_TCHAR  cwd[MAX_PATH_LENGTH];
+	int i;
+
+	for (i = 0; vmArgs != NULL && vmArgs[i] != NULL; i++) {
+		if (_tcsncmp(vmArgs[i], INSTANCE_AREA_PROP, _tcslen(INSTANCE_AREA_PROP)) == 0)
+			location = vmArgs[i] + _tcslen(INSTANCE_AREA_PROP);
+	}
+	/* -data is turned into osgi.instance.area by Main, the last one wins */
+	for (i = 1; i < argc - 1; i++) {
+		if (_tcsicmp(argv[i], DATA) == 0)
+			location = argv[++i];
+	}
+	if (location == NULL || location[0] == 0 || _tcsicmp(location, _T_ECLIPSE("@none")) == 0
+			|| _tcsicmp(location, _T_ECLIPSE("@noDefault")) == 0)
+		return NULL;
+
+	if (_tcsncmp(location, _T_ECLIPSE("@user.home"), 10) == 0) {
+		base = getenv("HOME");
+		location += 10;
+	} else if (_tcsncmp(location, _T_ECLIPSE("@user.dir"), 9) == 0) {
+		base = _tgetcwd(cwd, MAX_PATH_LENGTH);
+		location += 9;
+	} else {
+		if (_tcsncmp(location, _T_ECLIPSE("file:"), 5) == 0) {
+			location += 5;
+			if (_tcsncmp(location, _T_ECLIPSE("//"), 2) == 0)
+				location += 2;
+		}
+		if (location[0] != dirSeparator)
+			base = _tgetcwd(cwd, MAX_PATH_LENGTH);
+	}
+	if (base == NULL)
+		base = _T_ECLIPSE("");
+
+	result = malloc((_tcslen(base) + _tcslen(location) + 2) * sizeof(_TCHAR));
+	_stprintf(result, _T_ECLIPSE("%s%s%s"), base, (base[0] != 0 && location[0] != dirSeparator) ? _T_ECLIPSE("/") : _T_ECLIPSE(""), location);
+	i = _tcslen(result);
+	while (i > 1 && result[i - 1] == dirSeparator)
+		result[--i] = 0;
+	return result;
+}
+
+/* The lock file of the workspace, or NULL if no workspace was given or it will not be locked */
+static _TCHAR* getWorkspaceLock(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]) {
+	_TCHAR* location;
+	_TCHAR* result;
+	int i;
+
+	for (i = 0; vmArgs != NULL && vmArgs[i] != NULL; i++) {
+		if (_tcsncmp(vmArgs[i], INSTANCE_READONLY_PROP, _tcslen(INSTANCE_READONLY_PROP)) == 0)
+			return NULL;
+		if (_tcsncmp(vmArgs[i], LOCKING_PROP, _tcslen(LOCKING_PROP)) == 0
+				&& _tcscmp(vmArgs[i] + _tcslen(LOCKING_PROP), _T_ECLIPSE("java.nio")) != 0)
+			return NULL;	/* "none", or java.io which does not use fcntl */
+	}
+	location = getWorkspaceLocation(argc, argv, vmArgs);
+	if (location == NULL)
+		return NULL;
+	result = malloc((_tcslen(location) + _tcslen(WORKSPACE_LOCK) + 1) * sizeof(_TCHAR));
+	_stprintf(result, _T_ECLIPSE("%s%s"), location, WORKSPACE_LOCK);
+	free(location);
+	return result;
+}
+
+/* Ask for the lock Equinox takes with FileChannel.tryLock() without taking it.  Returns the
+ * owning process, -1 if it is held from elsewhere (an OFD lock or another host), 0 if free.
+ */
+static int getWorkspaceLockOwner(_TCHAR* lockFile) {
+	struct flock lock;
+	int fd = open(lockFile, O_RDONLY);
+	if (fd < 0)
+		return 0;
+	memset(&lock, 0, sizeof(lock));
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	if (fcntl(fd, F_GETLK, &lock) != 0)
+		lock.l_type = F_UNLCK;
+	close(fd);
+	if (lock.l_type == F_UNLCK)
+		return 0;
+	return lock.l_pid > 0 ? lock.l_pid : -1;
+}
+
+/* Fail before the VM is created if another instance holds the workspace.  Files that were to
+ * be opened go to that instance, it may still be starting and not listening for them yet.
+ */
+static void checkWorkspaceLock(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]) {
+	_TCHAR* lockFile = getWorkspaceLock(argc, argv, vmArgs);
+	_TCHAR* errorMsg;
+	_TCHAR  owner[32];
+	int pid;
+
+	if (lockFile == NULL)
+		return;
+	pid = getWorkspaceLockOwner(lockFile);
+	if (pid != 0 && debug)
+		_tprintf(_T_ECLIPSE("Workspace lock %s is held by process %d\n"), lockFile, pid);
+
+#ifndef MACOSX
+	if (pid != 0 && filePath != NULL && filePath[0] != NULL) {
+		int timeout = 60;
+		if (timeoutString != NULL)
+			_stscanf(timeoutString, _T_ECLIPSE("%d"), &timeout);
+		while (timeout-- > 0 && (pid = getWorkspaceLockOwner(lockFile)) != 0) {
+#ifdef LINUX
+			if (handoffSocket != NULL && handOffFiles(handoffSocket, filePath))
+				exit(0);
+#endif
+			/* one try per pass, reuseWorkbench would add a retry timer each time */
+			if (forwardFileOpen(filePath))
+				exit(0);
+			sleep(1);
+		}
+	}
+#endif
+	if (pid != 0) {
+		_TCHAR* workspace = _tcsdup(lockFile);
+		workspace[_tcslen(workspace) - _tcslen(WORKSPACE_LOCK)] = 0;
+		owner[0] = 0;
+		if (pid > 0)
+			_stprintf(owner, _T_ECLIPSE(" (process %d)"), pid);
+		errorMsg = malloc((_tcslen(workspaceMsg) + _tcslen(workspace) + _tcslen(officialName) + _tcslen(owner) + 1) * sizeof(_TCHAR));
+		_stprintf(errorMsg, workspaceMsg, workspace, officialName, owner);
+		if (!suppressErrors)
+			displayMessage(officialName, errorMsg);
+		else
+			_ftprintf(stderr, _T_ECLIPSE("%s:\n%s\n"), officialName, errorMsg);
+		exit(1);
+	}
+	free(lockFile);
+}
+#endif
+
+#ifdef LINUX
+/* The handoff socket of the instance for this workspace, or for this installation if no
+ * workspace was given.  Only the arguments are used, so that the key is the same for every
+ * launcher regardless of what it finds in its launcher.ini.
+ */
+static _TCHAR* getInstanceSocket(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]) {
+	_TCHAR* workspace = getWorkspaceLocation(argc, argv, vmArgs);
+	_TCHAR* result = getHandoffSocket(workspace != NULL ? workspace : program);
+	free(workspace);
+	return result;
+}
+#endif
+
+/* Java has finished starting up (see takedown_splash in eclipseJNI.c).  When the launcher
+ * exec'd java this runs in the Java process, so anything it needs from the launcher must
+ * come through the environment.
+ */
+void startupComplete() {
+	static int completed = 0;
+	if (completed)
+		return;
+	completed = 1;
+	MARK_PHASE("startup");
+
+#ifdef LINUX
+	{
+		_TCHAR* value;
+		if ((value = getLauncherVar(STARTUP_FD_VAR)) != NULL) {
+			completeStartup(atoi(value));
+			free(value);
+		}
+		if ((value = getLauncherVar(PREFETCH_RECORD_VAR)) != NULL) {
+			recordStartupFiles(value);
+			free(value);
+		}
+		/* stopped by the caller, it has the JNIEnv */
+		startupRecording = getLauncherVar(PROFILE_RECORDING_VAR);
+		if (defaultContext.launchMode == LAUNCH_JNI) {
+			releaseStartSlot();
+			/* the report shows what the startup took, before the launcher gives some back */
+			if (memReport)
+				reportMemory(&defaultContext, "startup", getpid());
+			reclaimStartupMemory(&defaultContext);
+		}
+	}
+#endif
+}
+
+#ifdef LINUX
+/* Java took down the splash of a VM exec'd with a control channel (see eclipseControl.c),
+ * this runs in the launcher while the VM is still there.  The stall monitor is told here
+ * too, the VM only tells it if it could load the launcher library (see JNIBridge).
+ */
+void controlStartupComplete() {
+	if (startupFd >= 0)
+		completeStartup(startupFd);
+	releaseStartSlot();
+	if (memReport)
+		reportMemory(&defaultContext, "startup", javaProcess);
+}
+#endif
+
 static void processDefaultAction(int argc, _TCHAR* argv[]) {
 	/* scan the arg list, no default if any start with '-' */
 	int i = 0;
@@ -861,16 +2181,26 @@ static void processDefaultAction(int argc, _TCHAR* argv[]) {
 		newArgv[0] = argv[0];
 		newArgv[1] = OPENFILE;
 		memcpy(&newArgv[2], &argv[1], argc * sizeof(_TCHAR*));
-		parseArgs(&newArgc, newArgv);
+		parseArgs(&defaultContext, &newArgc, newArgv);
 		free(newArgv);
 	}
 }
 
+/* Where the value of the option is saved when parsing for the given context.  Only the
+ * options of the launch context are honoured for other contexts than the default one.
+ */
+static void* getOptionValue(Option* option, LaunchContext* context) {
+	if (option->flag & CONTEXT_VALUE)
+		return (char*) context + ((char*) option->value - (char*) &defaultContext);
+	return (context == &defaultContext) ? option->value : NULL;
+}
+
 /*
  * Parse arguments of the command.
  */
-static void parseArgs(int* pArgc, _TCHAR* argv[]) {
+static void parseArgs(LaunchContext* context, int* pArgc, _TCHAR* argv[]) {
 	Option* option;
+	void* value;
 	int remArgs;
 	int index;
 	int i;
@@ -891,46 +2221,53 @@ static void parseArgs(int* pArgc, _TCHAR* argv[]) {
 		/* If the option is recognized by the launcher */
 		if (option != NULL) {
 			int optional = 0;
-			/* If the option requires a value and there is one, extract the value. */
-			if (option->value != NULL) {
-				if (option->flag & VALUE_IS_FLAG)
-					*((int *) option->value) = (option->flag & INVERT_FLAG) ? 0 : 1;
-				else {
-					int count = 1;
-					if (option->flag & VALUE_IS_LIST) {
-						/* count how many args, this is the -argument itself + following the non'-' args */
-						while (count + index < *pArgc && argv[count + index][0] != _T_ECLIPSE('-'))
-							count++;
-
-						/* allocate memory for a _TCHAR* list and initialize it with NULLs*/
-						*((void**) option->value) = malloc(count * sizeof(_TCHAR *));
-						memset(*((void **) option->value), 0, count * sizeof(_TCHAR *));
-
-						if (option->remove != 0)
-							option->remove = count;
-					}
+			int count = 1;
+			int remove = option->remove;
+
+			/* count how many args, this is the -argument itself + following the non'-' args.
+			 * The option table is shared by all launch contexts, the count is not kept in it. */
+			if (option->flag & VALUE_IS_LIST) {
+				while (count + index < *pArgc && argv[count + index][0] != _T_ECLIPSE('-'))
+					count++;
+				if (remove != 0)
+					remove = count;
+			}
 
-					for (i = 0; i < count; i++) {
-						if ((index + i + 1) < *pArgc) {
-							_TCHAR * next = argv[index + i + 1];
-							if (option->flag & ADJUST_PATH)
-								next = checkPath(next, getProgramDir(), 0);
-							if (next[0] != _T_ECLIPSE('-')) {
-								if (option->flag & VALUE_IS_LIST)
-									(*((_TCHAR***) option->value))[i] = next;
-								else
-									*((_TCHAR**) option->value) = next;
-							} else if (option->flag & OPTIONAL_VALUE) {
-								/* value was optional, and the next arg starts with '-' */
-								optional = 1;
-							}
+			/* If the option requires a value and there is one, extract the value.  The options
+			 * that are not part of the context being parsed are only removed. */
+			value = getOptionValue(option, context);
+			if (option->flag & VALUE_IS_FLAG) {
+				if (value != NULL)
+					*((int *) value) = (option->flag & INVERT_FLAG) ? 0 : 1;
+			} else {
+				if (value != NULL && (option->flag & VALUE_IS_LIST)) {
+					/* allocate memory for a _TCHAR* list and initialize it with NULLs*/
+					*((void**) value) = malloc(count * sizeof(_TCHAR *));
+					memset(*((void **) value), 0, count * sizeof(_TCHAR *));
+				}
+
+				for (i = 0; i < count; i++) {
+					if ((index + i + 1) < *pArgc) {
+						_TCHAR * next = argv[index + i + 1];
+						if (value != NULL && (option->flag & ADJUST_PATH))
+							next = checkPath(next, getProgramDir(), 0);
+						if (next[0] != _T_ECLIPSE('-')) {
+							if (value == NULL)
+								continue;
+							if (option->flag & VALUE_IS_LIST)
+								(*((_TCHAR***) value))[i] = next;
+							else
+								*((_TCHAR**) value) = next;
+						} else if (option->flag & OPTIONAL_VALUE) {
+							/* value was optional, and the next arg starts with '-' */
+							optional = 1;
 						}
 					}
 				}
 			}
 
 			/* If the option requires a flag to be set, set it. */
-			remArgs = option->remove - optional;
+			remArgs = remove - optional;
 		}
 
 		/* Remove any matched arguments from the list. */
@@ -1012,6 +2349,12 @@ static _TCHAR** getConfigArgs() {
 	int configArgc = 0;
 	int ret = 0;
 
+#ifdef LINUX
+	if (iniFile == NULL && embeddedIni != NULL) {
+		ret = readConfigData(embeddedIni, &configArgc, &configArgv);
+		return (ret == 0) ? configArgv : NULL;
+	}
+#endif
 	configFile = (iniFile != NULL) ? iniFile : getIniFile(program, consoleLauncher);
 	ret = readConfigFile(configFile, &configArgc, &configArgv);
 	if (ret == 0)
@@ -1110,8 +2453,9 @@ static void adjustVMArgs(_TCHAR *javaVM, _TCHAR *jniLib, _TCHAR **vmArgv[]) {
  *
  * Arguments are split into 2: vm arguments and program arguments
  */
-static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmArgv[], _TCHAR **progArgv[] )
+static void getVMCommand( LaunchContext* context, _TCHAR **vmArgv[], _TCHAR **progArgv[] )
 {
+	_TCHAR** reqVMarg[] = REQUIRED_VM_ARGS(context);
 	_TCHAR** vmArg;
     int     nReqVMarg = 0;
     int     nVMarg = 0;
@@ -1121,9 +2465,9 @@ static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmA
     int     dst;
 
 	/* If the user specified "-vmargs", add them instead of the default VM args. */
-	vmArg = (userVMarg != NULL) ? userVMarg : getArgVM( (launchMode == LAUNCH_JNI) ? jniLib : javaVM );
+	vmArg = (context->userVMarg != NULL) ? context->userVMarg : getArgVM( (context->launchMode == LAUNCH_JNI) ? context->jniLib : context->javaVM );
 
-	adjustVMArgs(javaVM, jniLib, &vmArg);
+	adjustVMArgs(context->javaVM, context->jniLib, &vmArg);
 
  	/* Calculate the number of VM arguments. */
  	while (vmArg[ nVMarg ] != NULL)
@@ -1134,22 +2478,22 @@ static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmA
  		nReqVMarg++;
 
 	/* VM argument list */
-	totalVMArgs = nVMarg + nReqVMarg + nEEargs + 1;
+	totalVMArgs = nVMarg + nReqVMarg + context->nEEargs + 1;
 	*vmArgv = malloc( totalVMArgs * sizeof(_TCHAR*) );
 
 	dst = 0;
 	for (src = 0; src < nVMarg; src++){
 		/*if the user specified a classpath, skip it */
-		if(_tcscmp(vmArg[src], cp) == 0){
+		if(_tcscmp(vmArg[src], context->cp) == 0){
 			src++;
 			continue;
 		}
     	(*vmArgv)[ dst++ ] = vmArg[ src ];
 	}
 
-	if (eeVMarg != NULL)
-		for (src = 0; src < nEEargs; src++)
-			(*vmArgv)[ dst++ ] = eeVMarg[ src ];
+	if (context->eeVMarg != NULL)
+		for (src = 0; src < context->nEEargs; src++)
+			(*vmArgv)[ dst++ ] = context->eeVMarg[ src ];
 
 	/* For each required VM arg */
 	for (src = 0; src < nReqVMarg; src++)
@@ -1165,7 +2509,7 @@ static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmA
      * VMARGS + vmArg + requiredVMargs
      *  + NULL)
      */
-    totalProgArgs  = 2 + 2 + 2 + 2 + 2 + 2 + 2 + 2 + 2 + 2 + 1 + argc + 2 + 1 + nVMarg + nEEargs + nReqVMarg + 1;
+    totalProgArgs  = 2 + 2 + 2 + 2 + 2 + 2 + 2 + 2 + 2 + 2 + 1 + context->argc + 2 + 1 + nVMarg + context->nEEargs + nReqVMarg + 1;
 	*progArgv = malloc( totalProgArgs * sizeof( _TCHAR* ) );
     dst = 0;
 
@@ -1180,7 +2524,7 @@ static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmA
     }
 
 	/* Append the show splash window command, if defined. */
-    if (!noSplash)
+    if (!context->noSplash)
     {
         (*progArgv)[ dst++ ] = SHOWSPLASH;
         if(splashBitmap != NULL)
@@ -1203,7 +2547,7 @@ static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmA
 
 	/* the startup jar */
 	(*progArgv)[ dst++ ] = STARTUP;
-	(*progArgv)[ dst++ ] = jarFile;
+	(*progArgv)[ dst++ ] = context->jarFile;
 
 	/* the protect mode */
 	if (protectMode) {
@@ -1215,31 +2559,31 @@ static void getVMCommand( int launchMode, int argc, _TCHAR* argv[], _TCHAR **vmA
 	(*progArgv)[ dst++ ] = appendVmargs ? APPEND_VMARGS : OVERRIDE_VMARGS;
 
 	/* Append the exit data command. */
-	if (sharedID) {
+	if (context->sharedID) {
 		(*progArgv)[ dst++ ] = EXITDATA;
-		(*progArgv)[ dst++ ] = sharedID;
+		(*progArgv)[ dst++ ] = context->sharedID;
 	}
 
 	/* Append the remaining user defined arguments. */
-    for (src = 1; src < argc; src++)
+    for (src = 1; src < context->argc; src++)
     {
-        (*progArgv)[ dst++ ] = argv[ src ];
+        (*progArgv)[ dst++ ] = context->argv[ src ];
     }
 
     /* Append VM and VMARGS to be able to relaunch using exit data. */
 	(*progArgv)[ dst++ ] = VM;
-	if(jniLib != NULL)
-		(*progArgv)[ dst++ ] = jniLib;
+	if(context->jniLib != NULL)
+		(*progArgv)[ dst++ ] = context->jniLib;
 	else
-		(*progArgv)[ dst++ ] = javaVM;
+		(*progArgv)[ dst++ ] = context->javaVM;
     (*progArgv)[ dst++ ] = VMARGS;
 
 	for (src = 0; src < nVMarg; src++)
     	(*progArgv)[ dst++ ] = vmArg[ src ];
 
-	if (eeVMarg != NULL)
-		for (src = 0; src < nEEargs; src++)
-			(*progArgv)[ dst++ ] = eeVMarg[ src ];
+	if (context->eeVMarg != NULL)
+		for (src = 0; src < context->nEEargs; src++)
+			(*progArgv)[ dst++ ] = context->eeVMarg[ src ];
 
     /* For each required VM arg */
     for (src = 0; src < nReqVMarg; src++)
@@ -1459,15 +2803,15 @@ static _TCHAR* findSplash(_TCHAR* splashArg) {
 	return NULL;
 }
 
-static _TCHAR* findStartupJar(){
+static _TCHAR* findStartupJar(LaunchContext* context){
 	_TCHAR * file, *ch;
 	_TCHAR * pluginsPath;
 	struct _stat stats;
 	size_t pathLength, progLength;
 
-	if( startupArg != NULL ) {
+	if( context->startupArg != NULL ) {
 		/* startup jar was specified on the command line */
-		ch = _tcsdup(startupArg);
+		ch = _tcsdup(context->startupArg);
 		/* check path will check relative paths against programDir and workingDir */
 		file = checkPath(ch, programDir, 1);
 		if(file != ch)
@@ -1497,8 +2841,12 @@ static _TCHAR* findStartupJar(){
 
 	/* equinox startup jar? */
 	file = findFile(pluginsPath, DEFAULT_EQUINOX_STARTUP);
-	if(file != NULL)
+	if(file != NULL) {
+		/* Main looks for the framework next to the startup jar, the plugins directory is indexed now */
+		context->frameworkLocation = findFile(pluginsPath, OSGI_FRAMEWORK);
+		free(pluginsPath);
 		return file;
+	}
 
 	/* old startup.jar? */
 	ch = OLD_STARTUP;
@@ -1514,16 +2862,23 @@ static _TCHAR* findStartupJar(){
  *
  * The memory allocated for the command array must be freed
  */
-static _TCHAR ** getRelaunchCommand( _TCHAR **vmCommand  )
+static _TCHAR ** getRelaunchCommand( LaunchContext* context, _TCHAR **vmCommand  )
 {
+	_TCHAR** reqVMarg[] = REQUIRED_VM_ARGS(context);
 	int i = -1, req = 0, begin = -1;
 	int idx = 0;
 	_TCHAR ** relaunch;
 
 	if (vmCommand == NULL) return NULL;
+	/* the required VM args that were set end the VM part of the command */
+	while (reqVMarg[req] != NULL && *reqVMarg[req] == NULL)
+		req++;
 	while(vmCommand[++i] != NULL){
-		if ( begin == -1 && _tcsicmp( vmCommand[i], *reqVMarg[req] ) == 0) {
-			if(reqVMarg[++req] == NULL || *reqVMarg[req] == NULL){
+		if ( begin == -1 && reqVMarg[req] != NULL && _tcsicmp( vmCommand[i], *reqVMarg[req] ) == 0) {
+			do {
+				req++;
+			} while (reqVMarg[req] != NULL && *reqVMarg[req] == NULL);
+			if (reqVMarg[req] == NULL) {
 				begin = i + 1;
 			}
 		}
@@ -1622,26 +2977,26 @@ static void fixDLLSearchPath() {
 
 /* Set the vm to use based on the given .ee file.
  */
-static int vmEEProps(_TCHAR * eeFile, _TCHAR ** msg) {
-	if (processEEProps(eeFile) != 0) {
+static int vmEEProps(LaunchContext* context, _TCHAR * eeFile, _TCHAR ** msg) {
+	if (processEEProps(context, eeFile) != 0) {
 		*msg = _tcsdup(eeFile);
 		return -1;
 	}
-	if (eeLibrary != NULL) {
-		jniLib = findVMLibrary(eeLibrary);
-		if (jniLib != NULL)
+	if (context->eeLibrary != NULL) {
+		context->jniLib = findVMLibrary(context->eeLibrary);
+		if (context->jniLib != NULL)
 			return LAUNCH_JNI;
 	}
 
-	if (eeConsole != NULL && (debug || needConsole || consoleLauncher) ) {
-		javaVM = findSymlinkCommand(eeConsole, 0);
-		if (javaVM != NULL)
+	if (context->eeConsole != NULL && (debug || needConsole || consoleLauncher) ) {
+		context->javaVM = findSymlinkCommand(context->eeConsole, 0);
+		if (context->javaVM != NULL)
 			return LAUNCH_EXE;
 	}
 
-	if (eeExecutable != NULL) {
-		javaVM = findSymlinkCommand(eeExecutable, 0);
-		if (javaVM != NULL)
+	if (context->eeExecutable != NULL) {
+		context->javaVM = findSymlinkCommand(context->eeExecutable, 0);
+		if (context->javaVM != NULL)
 			return LAUNCH_EXE;
 	}
 
@@ -1656,7 +3011,7 @@ static int vmEEProps(_TCHAR * eeFile, _TCHAR ** msg) {
  * return -1 if problem finding vm, the passed in msg points to the places we looked.  Caller should free
  * this memory.
  */
-static int determineVM(_TCHAR** msg) {
+static int determineVM(LaunchContext* context, _TCHAR** msg) {
 	_TCHAR* ch  = NULL;
 	_TCHAR* result = NULL;
 	_TCHAR* vmSearchPath = NULL;
@@ -1669,80 +3024,80 @@ static int determineVM(_TCHAR** msg) {
 #endif
 
 	/* vmName is passed in on command line with -vm */
-    if (vmName != NULL) {
-    	size_t length = _tcslen(vmName);
+    if (context->vmName != NULL) {
+    	size_t length = _tcslen(context->vmName);
     	/* remove the trailing separator */
-    	if (vmName[length - 1] == _T_ECLIPSE('/') || vmName[length - 1] == _T_ECLIPSE('\\')) {
-    		vmName[length - 1] = 0;
+    	if (context->vmName[length - 1] == _T_ECLIPSE('/') || context->vmName[length - 1] == _T_ECLIPSE('\\')) {
+    		context->vmName[length - 1] = 0;
     	}
 
-    	vmName = checkPath(vmName, programDir, 1);
-    	type = checkProvidedVMType(vmName);
+    	context->vmName = checkPath(context->vmName, programDir, 1);
+    	type = checkProvidedVMType(context->vmName);
     	switch (type) {
     	case VM_DIRECTORY:
     		/* vmName is a directory, look for default.ee */
-    		ch = malloc((_tcslen(vmName) + 1 + _tcslen(DEFAULT_EE) + 1) * sizeof(_TCHAR));
-    		_stprintf( ch, _T_ECLIPSE("%s%c%s"), vmName, dirSeparator, DEFAULT_EE );
+    		ch = malloc((_tcslen(context->vmName) + 1 + _tcslen(DEFAULT_EE) + 1) * sizeof(_TCHAR));
+    		_stprintf( ch, _T_ECLIPSE("%s%c%s"), context->vmName, dirSeparator, DEFAULT_EE );
 
     		result = findCommand(ch);
     		free(ch);
     		if (result == NULL) {
     			/* No default.ee file, look for default VM */
-    			ch = malloc((_tcslen(vmName) + 1 + _tcslen(defaultJava) + 1) * sizeof(_TCHAR));
-    			_stprintf( ch, _T_ECLIPSE("%s%c%s"), vmName, dirSeparator, defaultJava );
-    			javaVM = findSymlinkCommand(ch, 0);
+    			ch = malloc((_tcslen(context->vmName) + 1 + _tcslen(defaultJava) + 1) * sizeof(_TCHAR));
+    			_stprintf( ch, _T_ECLIPSE("%s%c%s"), context->vmName, dirSeparator, defaultJava );
+    			context->javaVM = findSymlinkCommand(ch, 0);
     			free(ch);
-    			if (javaVM == NULL) {
+    			if (context->javaVM == NULL) {
     				/* No vm executable, look for library */
-    				ch = malloc((_tcslen(vmName) + 1 + _tcslen(vmLibrary) + 1) * sizeof(_TCHAR));
-    				_stprintf( ch, _T_ECLIPSE("%s%c%s"), vmName, dirSeparator, vmLibrary );
-    				jniLib = findVMLibrary(ch);
-    				if (jniLib != ch)
+    				ch = malloc((_tcslen(context->vmName) + 1 + _tcslen(vmLibrary) + 1) * sizeof(_TCHAR));
+    				_stprintf( ch, _T_ECLIPSE("%s%c%s"), context->vmName, dirSeparator, vmLibrary );
+    				context->jniLib = findVMLibrary(ch);
+    				if (context->jniLib != ch)
     					free(ch);
-    				if (jniLib != NULL) {
+    				if (context->jniLib != NULL) {
     					return LAUNCH_JNI;
     				}
     				/* found nothing, return error */
-    				*msg = malloc( (3 * (_tcslen(vmName) + 2) + _tcslen(DEFAULT_EE) + _tcslen(defaultJava) + _tcslen(vmLibrary) + 1) * sizeof(_TCHAR));
-    				_stprintf( *msg, _T_ECLIPSE("%s%c%s\n%s%c%s\n%s%c%s"), vmName, dirSeparator, DEFAULT_EE,
-    																	   vmName, dirSeparator, defaultJava,
-    																	   vmName, dirSeparator, vmLibrary);
+    				*msg = malloc( (3 * (_tcslen(context->vmName) + 2) + _tcslen(DEFAULT_EE) + _tcslen(defaultJava) + _tcslen(vmLibrary) + 1) * sizeof(_TCHAR));
+    				_stprintf( *msg, _T_ECLIPSE("%s%c%s\n%s%c%s\n%s%c%s"), context->vmName, dirSeparator, DEFAULT_EE,
+    																	   context->vmName, dirSeparator, defaultJava,
+    																	   context->vmName, dirSeparator, vmLibrary);
     				return -1;
     			}
     			break;
     		}
 
     		/* else default.ee does exist */
-    		vmName = result;
+    		context->vmName = result;
     		/* fall through to VM_EE_PROPS*/
     	case VM_EE_PROPS:
-    		return vmEEProps(vmName, msg);
+    		return vmEEProps(context, context->vmName, msg);
 
     	case VM_LIBRARY:
 #ifdef MACOSX
     		skipJava9ParamRemoval = 1;
 #endif
-    		ch = findCommand(vmName);
+    		ch = findCommand(context->vmName);
     		if(ch != NULL) {
-    			jniLib = findVMLibrary(ch);
-    			if (ch != jniLib)
+    			context->jniLib = findVMLibrary(ch);
+    			if (ch != context->jniLib)
     				free(ch);
     			return LAUNCH_JNI;
     		}
     		/* file didn't exist, error */
-    		if (firstDirSeparator( vmName ) == NULL) {
+    		if (firstDirSeparator( context->vmName ) == NULL) {
     			/* if vmName doesn't contain a dirSeparator, we looked on the path */
-    			*msg = malloc((_tcslen(pathMsg) + _tcslen(vmName)) * sizeof(_TCHAR));
-    			_stprintf( *msg, pathMsg,vmName );
+    			*msg = malloc((_tcslen(pathMsg) + _tcslen(context->vmName)) * sizeof(_TCHAR));
+    			_stprintf( *msg, pathMsg,context->vmName );
     		} else {
-    			*msg = _tcsdup(vmName);
+    			*msg = _tcsdup(context->vmName);
     		}
     		return -1;
 
     	default:
     		/*otherwise, assume executable */
-    		javaVM = findSymlinkCommand(vmName, 0);
-    		if(javaVM != NULL) {
+    		context->javaVM = findSymlinkCommand(context->vmName, 0);
+    		if(context->javaVM != NULL) {
 #ifdef MACOSX
     			/* right now, we are always doing JNI on Mac */
     			break;
@@ -1751,18 +3106,18 @@ static int determineVM(_TCHAR** msg) {
 #endif
     		}
     		/* file didn't exist, error */
-    		if (firstDirSeparator( vmName ) == NULL) {
+    		if (firstDirSeparator( context->vmName ) == NULL) {
     			/* if vmName doesn't contain a dirSeparator, we looked on the path */
-    			*msg = malloc((_tcslen(pathMsg) + _tcslen(vmName)) * sizeof(_TCHAR));
-    			_stprintf( *msg, pathMsg, vmName );
+    			*msg = malloc((_tcslen(pathMsg) + _tcslen(context->vmName)) * sizeof(_TCHAR));
+    			_stprintf( *msg, pathMsg, context->vmName );
     		} else {
-    			*msg = _tcsdup(vmName);
+    			*msg = _tcsdup(context->vmName);
     		}
    			return -1;
     	}
     }
 
-    if (vmName == NULL) {
+    if (context->vmName == NULL) {
     	/* no vm specified, Try to find the VM shipped with eclipse. */
 
     	/* look first for default.ee */
@@ -1771,7 +3126,7 @@ static int determineVM(_TCHAR** msg) {
 		result = findCommand(ch);
 		free(ch);
     	if (result != NULL) {
-    		type = vmEEProps(result, msg);
+    		type = vmEEProps(context, result, msg);
     		free(result);
     		return type;
     	}
@@ -1781,14 +3136,33 @@ static int determineVM(_TCHAR** msg) {
         _stprintf( ch, _T_ECLIPSE("%s%s%s"), programDir, shippedVMDir, defaultJava );
         vmSearchPath = _tcsdup(ch);
 
-        javaVM = findSymlinkCommand( ch, 0 );
+        context->javaVM = findSymlinkCommand( ch, 0 );
         free(ch);
     }
 
-    if (javaVM == NULL) {
+#ifdef LINUX
+    if (context->javaVM == NULL && (context->vmVersion != NULL || context->vmVendor != NULL)) {
+    	/* the ini constrains which of the installed JDKs to use */
+    	context->javaVM = findRegisteredJava(context->vmVersion, context->vmVendor);
+    	if (context->javaVM == NULL && context->vmVersion != NULL) {
+    		/* the java on the PATH may well be outside of the range, don't pretend it satisfies it */
+    		*msg = malloc((_tcslen(vmVersionMsg) + _tcslen(context->vmVersion) + 1) * sizeof(_TCHAR));
+    		_stprintf(*msg, vmVersionMsg, context->vmVersion);
+    		if (vmSearchPath != NULL)
+    			free(vmSearchPath);
+    		return -1;
+    	}
+    	if (context->javaVM == NULL)
+    		_ftprintf(stderr, vmVendorMsg, context->vmVendor, defaultJava);
+    	else if (debug)
+    		_tprintf( _T_ECLIPSE("Selected installed JDK: %s\n"), context->javaVM );
+    }
+#endif
+
+    if (context->javaVM == NULL) {
     	/* vm not found yet, look for one on the search path, but don't resolve symlinks */
-    	javaVM = findSymlinkCommand(defaultJava, 0);
-    	if (javaVM == NULL) {
+    	context->javaVM = findSymlinkCommand(defaultJava, 0);
+    	if (context->javaVM == NULL) {
     		/* can't find vm, error */
     		ch = malloc( (_tcslen(pathMsg) + _tcslen(defaultJava) + 1) * sizeof(_TCHAR));
     		_stprintf(ch, pathMsg, defaultJava);
@@ -1809,18 +3183,18 @@ static int determineVM(_TCHAR** msg) {
 
 #ifndef DEFAULT_JAVA_EXEC
 	/* resolve symlinks for finding the library */
-	ch = resolveSymlinks(javaVM);
-    jniLib = findVMLibrary(ch);
-    if (ch != jniLib && ch != javaVM)
+	ch = resolveSymlinks(context->javaVM);
+    context->jniLib = findVMLibrary(ch);
+    if (ch != context->jniLib && ch != context->javaVM)
 		free(ch);
-    if (jniLib != NULL)
+    if (context->jniLib != NULL)
     	return LAUNCH_JNI;
 #endif
 
     return LAUNCH_EXE;
 }
 
-static int processEEProps(_TCHAR* eeFile)
+static int processEEProps(LaunchContext* context, _TCHAR* eeFile)
 {
 	_TCHAR ** argv;
 	_TCHAR * c1, * c2;
@@ -1833,8 +3207,8 @@ static int processEEProps(_TCHAR* eeFile)
 	if(readConfigFile(eeFile, &argc, &argv) != 0)
 		return -1;
 
-	nEEargs = argc;
-	eeVMarg = argv;
+	context->nEEargs = argc;
+	context->eeVMarg = argv;
 
 	eeDir = _tcsdup(eeFile);
 	c1 = lastDirSeparator( eeDir );
@@ -1870,7 +3244,7 @@ static int processEEProps(_TCHAR* eeFile)
         if(option != NULL) {
         	++matches;
         	if (option->flag & VALUE_IS_FLAG)
-        		*((int*)option->value) = 1;
+        		*((int*)getOptionValue(option, context)) = 1;
         	else {
         		c1 = malloc( (_tcslen(argv[index]) - _tcslen(option->name) + 1) *sizeof(_TCHAR));
             	_tcscpy(c1, argv[index] + _tcslen(option->name));
@@ -1885,24 +3259,27 @@ static int processEEProps(_TCHAR* eeFile)
         				c1 = c2;
         			}
         		}
-    			*((_TCHAR**)option->value) = c1;
+    			*((_TCHAR**)getOptionValue(option, context)) = c1;
         	}
         	if(matches == eeOptionsSize)
         		break;
         }
     }
     /* set ee.home, ee.filename variables, and NULL */
-    argv = realloc(argv, (nEEargs + 3) * sizeof(_TCHAR*));
+    argv = realloc(argv, (context->nEEargs + 3) * sizeof(_TCHAR*));
 
     c1 = malloc( (_tcslen(EE_HOME) + _tcslen(eeDir) + 1) * sizeof(_TCHAR));
     _stprintf(c1, _T_ECLIPSE("%s%s"), EE_HOME, eeDir);
-    argv[nEEargs++] = c1;
+    argv[context->nEEargs++] = c1;
 
     c1 = malloc( (_tcslen(EE_FILENAME) + _tcslen(eeFile) + 1) * sizeof(_TCHAR));
     _stprintf(c1, _T_ECLIPSE("%s%s"), EE_FILENAME, eeFile);
-    argv[nEEargs++] = c1;
+    argv[context->nEEargs++] = c1;
+
+    argv[context->nEEargs] = NULL;
 
-    argv[nEEargs] = NULL;
+    /* findVMLibrary looks at the global */
+    eeLibPath = context->eeLibPath;
 
     free(eeDir);
     return 0;
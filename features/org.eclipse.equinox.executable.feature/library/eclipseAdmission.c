@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Launch admission for --launcher.maxConcurrentStarts
+ *
+ * Many instances started at once compete for the CPU and the disk while they
+ * create their VM, load classes and read the plugins, and all of them take
+ * longer than they would one after the other.  A launcher starts its VM only
+ * while it holds one of the start slots, and gives it back once Java has taken
+ * down the splash or the application is running (see startupComplete() in
+ * eclipse.c), or when the VM exits.
+ *
+ * The slots are the files slot-<n> in /tmp/eclipse-starts-<uid>, held with an
+ * exclusive flock, which the kernel releases if the launcher dies.  Waiting
+ * launchers queue with a ticket wait-<time>-<pid>, locked the same way.  Only
+ * the one with the oldest live ticket tries the slots, so the launchers are
+ * admitted first come, first served.  A ticket nobody holds the lock of is
+ * left behind by a launcher that died and is removed.
+ */
+
+#include "eclipseAdmission.h"
+
+#include <sys/types.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define QUEUE_POLL		50		/* milliseconds between two looks at the slots */
+#define TICKET_PREFIX	"wait-"
+
+static int slotFd = -1;
+
+static long long getTime() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/* The queue of this user, NULL if it can't be used */
+static char* getQueueDir() {
+	char* dir = malloc(64);
+	struct stat stats;
+
+	sprintf(dir, "/tmp/eclipse-starts-%d", (int) getuid());
+	mkdir(dir, 0700);
+	/* anybody may have created it */
+	if (lstat(dir, &stats) != 0 || !S_ISDIR(stats.st_mode) || stats.st_uid != getuid()) {
+		free(dir);
+		return NULL;
+	}
+	return dir;
+}
+
+static char* childPath(char* dir, char* name) {
+	char* result = malloc(strlen(dir) + 1 + strlen(name) + 1);
+	sprintf(result, "%s/%s", dir, name);
+	return result;
+}
+
+/* Open the file and lock it without waiting, returns the descriptor or -1 if somebody holds the lock */
+static int tryLock(char* path, int flags) {
+	int fd = open(path, flags | O_RDWR | O_CLOEXEC, 0600);
+	int error;
+
+	if (fd < 0)
+		return -1;
+	if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+		error = errno;
+		close(fd);
+		errno = error;
+		return -1;
+	}
+	return fd;
+}
+
+/* Take a ticket, locked before it appears under its name so that nobody takes it for a stale one */
+static int takeTicket(char* dir, char** ticket) {
+	struct timespec now;
+	char name[64];
+	char* temp;
+	int fd;
+
+	sprintf(name, "tmp-%d", (int) getpid());
+	temp = childPath(dir, name);
+	fd = tryLock(temp, O_CREAT | O_TRUNC);
+	if (fd >= 0) {
+		clock_gettime(CLOCK_REALTIME, &now);
+		sprintf(name, TICKET_PREFIX "%020lld-%010d", (long long) now.tv_sec * 1000000000LL + now.tv_nsec, (int) getpid());
+		*ticket = childPath(dir, name);
+		if (rename(temp, *ticket) != 0) {
+			unlink(temp);
+			close(fd);
+			free(*ticket);
+			*ticket = NULL;
+			fd = -1;
+		}
+	}
+	free(temp);
+	return fd;
+}
+
+/* Is ticket the oldest one whose launcher is still waiting */
+static int isFirst(char* dir, char* ticket) {
+	char* name = strrchr(ticket, '/') + 1;
+	struct dirent* entry;
+	DIR* queue = opendir(dir);
+	int first = 1;
+
+	if (queue == NULL)
+		return 1;
+	while (first && (entry = readdir(queue)) != NULL) {
+		char* path;
+		int fd;
+
+		if (strncmp(entry->d_name, TICKET_PREFIX, strlen(TICKET_PREFIX)) != 0 || strcmp(entry->d_name, name) >= 0)
+			continue;
+		path = childPath(dir, entry->d_name);
+		fd = tryLock(path, 0);
+		if (fd >= 0) {
+			/* its launcher is gone */
+			unlink(path);
+			close(fd);
+		} else if (errno != ENOENT) {
+			first = 0;
+		}
+		free(path);
+	}
+	closedir(queue);
+	return first;
+}
+
+static int trySlots(char* dir, int maxStarts) {
+	char name[32];
+	char* path;
+	int i;
+
+	for (i = 0; i < maxStarts && slotFd < 0; i++) {
+		sprintf(name, "slot-%d", i);
+		path = childPath(dir, name);
+		slotFd = tryLock(path, O_CREAT);
+		free(path);
+	}
+	return slotFd >= 0;
+}
+
+int acquireStartSlot(int maxStarts, int timeout, long* waited) {
+	long long start = getTime();
+	struct timespec poll = { 0, QUEUE_POLL * 1000000L };
+	char* dir;
+	char* ticket = NULL;
+	int ticketFd;
+
+	*waited = 0;
+	if (slotFd >= 0)
+		return 0;
+	if ((dir = getQueueDir()) == NULL)
+		return -1;
+	if ((ticketFd = takeTicket(dir, &ticket)) < 0) {
+		free(dir);
+		return -1;
+	}
+	while (!(isFirst(dir, ticket) && trySlots(dir, maxStarts))) {
+		if (getTime() - start >= timeout * 1000LL)
+			break;
+		nanosleep(&poll, NULL);
+	}
+	unlink(ticket);
+	close(ticketFd);
+	free(ticket);
+	free(dir);
+	*waited = (long) (getTime() - start);
+	return (slotFd >= 0) ? 0 : -1;
+}
+
+void releaseStartSlot() {
+	if (slotFd >= 0) {
+		close(slotFd);
+		slotFd = -1;
+	}
+}
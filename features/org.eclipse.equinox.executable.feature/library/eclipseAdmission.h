@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_ADMISSION_H
+#define ECLIPSE_ADMISSION_H
+
+/* Launch admission for --launcher.maxConcurrentStarts, Linux only */
+
+/**
+ * Wait until fewer than maxStarts launchers of this user are starting a
+ * VM on this host, for at most timeout seconds.  Launchers are admitted
+ * in the order they started to wait.  waited is set to the milliseconds
+ * spent in the queue.  Returns 0 if this launcher holds a start slot, -1
+ * if it timed out or there is no queue; it should start anyway.
+ */
+extern int acquireStartSlot(int maxStarts, int timeout, long* waited);
+
+/**
+ * Give the slot taken with acquireStartSlot() to the next launcher.  Does
+ * nothing if this launcher holds none.
+ */
+extern void releaseStartSlot();
+
+#endif /* ECLIPSE_ADMISSION_H */
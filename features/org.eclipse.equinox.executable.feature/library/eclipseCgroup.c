@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Cgroup v2 placement for --launcher.cgroup
+ *
+ * Several instances sharing a host compete for memory, CPU and disk.  Each
+ * launcher moves itself into a group of its own, eclipse-<pid> below the
+ * cgroup it was started in, so the instance can be limited and weighted and
+ * its pressure stall information tells which instance had to wait.
+ *
+ * cgroup v2 does not allow processes in a group whose controllers are enabled
+ * for its children, so the controllers are enabled in the parent after the
+ * launcher left it.  That only works if nothing else runs in the parent.
+ * Started from a shell the launcher shares its cgroup with the shell, so it
+ * first asks the systemd user manager to move it into a delegated transient
+ * scope of its own, eclipse-<pid>.scope, as systemd-run --scope would.
+ *
+ * The group stays behind when the launcher exits, it can't remove the group
+ * it runs in.  Empty groups of launchers that are gone are removed the next
+ * time.
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipseCgroup.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define GROUP_PREFIX "eclipse-"
+#define SCOPE_WAIT		1000	/* milliseconds systemd gets to move the launcher into its scope */
+
+static char* groupDir = NULL;
+
+static char* pressureFiles[] = { "cpu.pressure", "memory.pressure", "io.pressure", NULL };
+
+/* The directory of the cgroup this process runs in, NULL if cgroup v2 isn't mounted */
+static char* getOwnCgroup() {
+	char line[4096];
+	char mount[1024] = "", path[2048] = "";
+	char* result;
+	FILE* file;
+
+	/* 36 25 0:31 / /sys/fs/cgroup rw,nosuid shared:9 - cgroup2 cgroup2 rw */
+	if ((file = fopen("/proc/self/mountinfo", "r")) == NULL)
+		return NULL;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char* type = strstr(line, " - cgroup2 ");
+		if (type != NULL && sscanf(line, "%*s %*s %*s %*s %1023s", mount) == 1)
+			break;
+		mount[0] = 0;
+	}
+	fclose(file);
+
+	/* 0::/user.slice/user-1000.slice/app.slice/eclipse.scope */
+	if (mount[0] == 0 || (file = fopen("/proc/self/cgroup", "r")) == NULL)
+		return NULL;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (strncmp(line, "0::", 3) == 0 && sscanf(line + 3, "%2047s", path) == 1)
+			break;
+		path[0] = 0;
+	}
+	fclose(file);
+	if (path[0] != '/')
+		return NULL;
+
+	result = malloc(strlen(mount) + strlen(path) + 1);
+	sprintf(result, "%s%s", mount, strcmp(path, "/") == 0 ? "" : path);
+	return result;
+}
+
+/* Whether processes other than this one run in group */
+static int isShared(char* group) {
+	char* path = malloc(strlen(group) + 16);
+	FILE* file;
+	int pid, result = 0;
+
+	sprintf(path, "%s/cgroup.procs", group);
+	file = fopen(path, "r");
+	free(path);
+	if (file == NULL)
+		return 0;
+	while (!result && fscanf(file, "%d", &pid) == 1)
+		result = (pid != getpid());
+	fclose(file);
+	return result;
+}
+
+/* Have the systemd user manager move this process into a delegated scope of its own,
+ * returns the scope's cgroup or NULL.  busctl makes the call, no D-Bus library needed.
+ */
+static char* moveToScope(char* group) {
+	char unit[32], pid[16];
+	char* args[] = { "busctl", "--user", "--quiet", "call", "org.freedesktop.systemd1", "/org/freedesktop/systemd1",
+		"org.freedesktop.systemd1.Manager", "StartTransientUnit", "ssa(sv)a(sa(sv))", unit, "fail",
+		"2", "PIDs", "au", "1", pid, "Delegate", "b", "true", "0", NULL };
+	char* result;
+	pid_t child;
+	int status, waited;
+
+	sprintf(unit, "eclipse-%d.scope", (int) getpid());
+	sprintf(pid, "%d", (int) getpid());
+	if ((child = fork()) == 0) {
+		int null = open("/dev/null", O_RDWR);
+		dup2(null, STDOUT_FILENO);
+		dup2(null, STDERR_FILENO);
+		execvp(args[0], args);
+		_exit(127);
+	}
+	if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return NULL;
+
+	/* the job that moves the process runs after the call returned */
+	for (waited = 0; waited < SCOPE_WAIT; waited += 10) {
+		if ((result = getOwnCgroup()) != NULL && strcmp(result, group) != 0)
+			return result;
+		free(result);
+		usleep(10000);
+	}
+	return NULL;
+}
+
+/* Remove the empty groups of launchers that are gone */
+static void removeStaleGroups(char* parent) {
+	struct dirent* entry;
+	char* path;
+	DIR* dir = opendir(parent);
+
+	if (dir == NULL)
+		return;
+	while ((entry = readdir(dir)) != NULL) {
+		int pid;
+		if (strncmp(entry->d_name, GROUP_PREFIX, strlen(GROUP_PREFIX)) != 0)
+			continue;
+		pid = atoi(entry->d_name + strlen(GROUP_PREFIX));
+		if (pid <= 0 || pid == getpid() || kill(pid, 0) == 0 || errno != ESRCH)
+			continue;
+		path = malloc(strlen(parent) + strlen(entry->d_name) + 2);
+		sprintf(path, "%s/%s", parent, entry->d_name);
+		rmdir(path);	/* fails if something still runs in it */
+		free(path);
+	}
+	closedir(dir);
+}
+
+static int writeCgroupFile(char* dir, char* name, char* value) {
+	int result = -1;
+	char* path = malloc(strlen(dir) + strlen(name) + 2);
+	FILE* file;
+
+	sprintf(path, "%s/%s", dir, name);
+	if ((file = fopen(path, "w")) != NULL) {
+		/* the kernel reports the error on the write */
+		result = (fputs(value, file) >= 0 && fflush(file) == 0) ? 0 : -1;
+		if (fclose(file) != 0)
+			result = -1;
+	}
+	free(path);
+	return result;
+}
+
+static void appendMessage(char** msg, char* format, char* name, char* value) {
+	size_t length = (*msg != NULL) ? strlen(*msg) : 0;
+	char* reason = strerror(errno);
+
+	*msg = realloc(*msg, length + strlen(format) + strlen(name) + strlen(value) + strlen(reason) + 4);
+	if (length > 0)
+		(*msg)[length++] = '\n';
+	sprintf(*msg + length, format, name, value, reason);
+}
+
+int joinCgroup(char* spec, char** msg) {
+	char* parent = getOwnCgroup();
+	char* settings;
+	char* setting;
+	char* next;
+	int result = 0;
+
+	*msg = NULL;
+	if (parent == NULL) {
+		*msg = strdup("cgroup v2 is not available");
+		return -1;
+	}
+	if (isShared(parent)) {
+		char* scope = moveToScope(parent);
+		if (scope != NULL) {
+			free(parent);
+			parent = scope;
+		}
+	}
+	removeStaleGroups(parent);
+
+	groupDir = malloc(strlen(parent) + strlen(GROUP_PREFIX) + 16);
+	sprintf(groupDir, "%s/" GROUP_PREFIX "%d", parent, (int) getpid());
+	if ((mkdir(groupDir, 0755) != 0 && errno != EEXIST) || writeCgroupFile(groupDir, "cgroup.procs", "0") != 0) {
+		appendMessage(msg, "Unable to move to %s%s: %s", groupDir, "");
+		rmdir(groupDir);
+		free(groupDir);
+		free(parent);
+		groupDir = NULL;
+		return -1;
+	}
+
+	/* memory.peak needs the memory controller even without settings */
+	writeCgroupFile(parent, "cgroup.subtree_control", "+memory");
+
+	settings = strdup(spec);
+	for (setting = settings; setting != NULL; setting = next) {
+		char* value = strchr(setting, '=');
+		char controller[64] = "+";
+
+		if ((next = strchr(setting, ',')) != NULL)
+			*next++ = 0;
+		if (*setting == 0)
+			continue;
+		if (value == NULL || strchr(setting, '/') != NULL || strchr(setting, '.') == NULL) {
+			errno = EINVAL;
+			appendMessage(msg, "Invalid cgroup setting %s%s: %s", setting, "");
+			result = -1;
+			continue;
+		}
+		*value++ = 0;
+
+		/* enable the controller of the file in the parent, memory for memory.high */
+		strncat(controller, setting, sizeof(controller) - 2);
+		*strchr(controller, '.') = 0;
+		if (writeCgroupFile(parent, "cgroup.subtree_control", controller) != 0) {
+			/* EBUSY: other processes still run in the parent, there was no scope */
+			appendMessage(msg, "Unable to enable the %s controller for %s: %s", controller + 1, setting);
+			result = -1;
+		} else if (writeCgroupFile(groupDir, setting, value) != 0) {
+			appendMessage(msg, "Unable to set %s to %s: %s", setting, value);
+			result = -1;
+		}
+	}
+	free(settings);
+	free(parent);
+	return result;
+}
+
+int reportCgroup(char* reportFile) {
+	char line[512];
+	char* path;
+	FILE* report;
+	FILE* file;
+	int i;
+
+	if (groupDir == NULL || (report = fopen(reportFile, "w")) == NULL)
+		return -1;
+	path = malloc(strlen(groupDir) + 32);
+
+	fprintf(report, "cgroup %s\n", groupDir);
+	for (i = 0; pressureFiles[i] != NULL; i++) {
+		sprintf(path, "%s/%s", groupDir, pressureFiles[i]);
+		if ((file = fopen(path, "r")) == NULL)
+			continue;
+		/* some avg10=0.00 avg60=0.00 avg300=0.00 total=0 */
+		while (fgets(line, sizeof(line), file) != NULL)
+			fprintf(report, "%s %s", pressureFiles[i], line);
+		fclose(file);
+	}
+	sprintf(path, "%s/memory.peak", groupDir);
+	if ((file = fopen(path, "r")) != NULL) {
+		if (fgets(line, sizeof(line), file) != NULL)
+			fprintf(report, "memory.peak %s", line);
+		fclose(file);
+	}
+
+	free(path);
+	return fclose(report) == 0 ? 0 : -1;
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_CGROUP_H
+#define ECLIPSE_CGROUP_H
+
+/* Cgroup v2 placement for --launcher.cgroup, Linux only */
+
+/**
+ * Move this process into a new cgroup of its own, created below the
+ * cgroup it runs in, which must be delegated to the user (for example
+ * with systemd-run --user --scope -p Delegate=yes).  If other processes
+ * run in that cgroup the process first moves to a transient scope of the
+ * systemd user manager.  The VM started afterwards, in this process or
+ * exec'd, runs in that group.
+ *
+ * spec is a comma separated list of <file>=<value> settings for the new
+ * group, like memory.high=4G,cpu.weight=50,io.weight=200.  The
+ * controllers they need are enabled in the parent.
+ *
+ * Returns 0 if the process was moved and all settings were applied,
+ * otherwise msg is set to a description of the problem, to be freed by
+ * the caller.
+ */
+extern int joinCgroup(char* spec, char** msg);
+
+/**
+ * Write the pressure stall information (cpu, memory and io) and the
+ * memory peak of the group joined with joinCgroup() to reportFile.
+ * Returns 0 if success.
+ */
+extern int reportCgroup(char* reportFile);
+
+#endif /* ECLIPSE_CGROUP_H */
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Checkpoint images for --launcher.checkpoint and --launcher.restore
+ *
+ * An image is a directory <dir>/<key> that a CRaC capable VM writes to when
+ * started with -XX:CRaCCheckpointTo.  CRIU leaves an inventory.img behind once
+ * the dump went through; the launcher then drops a stamp file next to it so
+ * that partially written images are never restored from.
+ */
+
+#include "eclipseCheckpoint.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CHECKPOINT_STAMP	"eclipse.checkpoint"
+#define CRIU_INVENTORY		"inventory.img"
+
+/* 64 bit FNV-1a */
+#define FNV_OFFSET	0xcbf29ce484222325ULL
+#define FNV_PRIME	0x100000001b3ULL
+
+static unsigned long long hashBytes(unsigned long long hash, const void* data, size_t length) {
+	const unsigned char* bytes = data;
+	size_t i;
+	for (i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+static unsigned long long hashString(unsigned long long hash, const char* str) {
+	if (str == NULL)
+		str = "";
+	/* include the terminator so that "ab","c" and "a","bc" differ */
+	return hashBytes(hash, str, strlen(str) + 1);
+}
+
+static unsigned long long hashFile(unsigned long long hash, const char* path) {
+	struct stat stats;
+	hash = hashString(hash, path);
+	if (path != NULL && stat(path, &stats) == 0) {
+		hash = hashBytes(hash, &stats.st_ino, sizeof(stats.st_ino));
+		hash = hashBytes(hash, &stats.st_size, sizeof(stats.st_size));
+		hash = hashBytes(hash, &stats.st_mtime, sizeof(stats.st_mtime));
+	}
+	return hash;
+}
+
+static char* childPath(const char* dir, const char* name) {
+	char* result = malloc(strlen(dir) + 1 + strlen(name) + 1);
+	sprintf(result, "%s/%s", dir, name);
+	return result;
+}
+
+static int fileExists(const char* dir, const char* name) {
+	struct stat stats;
+	char* path = childPath(dir, name);
+	int result = (stat(path, &stats) == 0);
+	free(path);
+	return result;
+}
+
+/* CRIU writes a flat directory of image files, no need to recurse */
+static void clearDirectory(const char* dir) {
+	DIR* handle = opendir(dir);
+	struct dirent* entry;
+	if (handle == NULL)
+		return;
+	while ((entry = readdir(handle)) != NULL) {
+		char* path;
+		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+			continue;
+		path = childPath(dir, entry->d_name);
+		unlink(path);
+		free(path);
+	}
+	closedir(handle);
+}
+
+/* Remove the images we created for other keys, leave anything else in the directory alone */
+static void removeStaleImages(const char* dir, const char* key) {
+	DIR* handle = opendir(dir);
+	struct dirent* entry;
+	if (handle == NULL)
+		return;
+	while ((entry = readdir(handle)) != NULL) {
+		char* path;
+		if (entry->d_name[0] == '.' || strcmp(entry->d_name, key) == 0)
+			continue;
+		path = childPath(dir, entry->d_name);
+		if (fileExists(path, CHECKPOINT_STAMP)) {
+			clearDirectory(path);
+			rmdir(path);
+		}
+		free(path);
+	}
+	closedir(handle);
+}
+
+char* getCheckpointImage(char* dir, char* iniFile, char* javaVM, char* pluginsDir, int argc, char* argv[]) {
+	unsigned long long hash = FNV_OFFSET;
+	char key[17];
+	int i;
+
+	hash = hashFile(hash, iniFile);
+	hash = hashFile(hash, javaVM);
+	hash = hashFile(hash, pluginsDir);
+	for (i = 0; i < argc; i++)
+		hash = hashString(hash, argv[i]);
+
+	sprintf(key, "%016llx", hash);
+	removeStaleImages(dir, key);
+	return childPath(dir, key);
+}
+
+int isCheckpointValid(char* image) {
+	return fileExists(image, CHECKPOINT_STAMP);
+}
+
+int completeCheckpoint(char* image) {
+	char* path;
+	FILE* file;
+
+	if (!fileExists(image, CRIU_INVENTORY))
+		return 0;
+
+	path = childPath(image, CHECKPOINT_STAMP);
+	file = fopen(path, "w");
+	free(path);
+	if (file == NULL)
+		return 0;
+	fclose(file);
+	return 1;
+}
+
+int resetCheckpoint(char* image) {
+	char* parent = strdup(image);
+	char* separator = strrchr(parent, '/');
+
+	if (separator != NULL && separator != parent) {
+		*separator = 0;
+		mkdir(parent, 0755);
+	}
+	free(parent);
+
+	clearDirectory(image);
+	if (mkdir(image, 0700) != 0) {
+		struct stat stats;
+		return (stat(image, &stats) == 0 && S_ISDIR(stats.st_mode)) ? 0 : -1;
+	}
+	return 0;
+}
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_CHECKPOINT_H
+#define ECLIPSE_CHECKPOINT_H
+
+/* Checkpoint/restore (CRaC) utilities, Linux only */
+
+/**
+ * Returns the location of the checkpoint image for this launch inside
+ * the given directory.  The image is keyed by the inputs that decide
+ * which VM and which bundles get started: the launcher ini file, the
+ * java executable, the plugins directory and the command line, so a
+ * change to any of them selects a different image.  Images for other
+ * keys found in the directory are removed.
+ *
+ * The result must be freed with free().
+ */
+extern char* getCheckpointImage(char* dir, char* iniFile, char* javaVM, char* pluginsDir, int argc, char* argv[]);
+
+/**
+ * Returns 1 if the image contains a completed checkpoint that
+ * can be restored from.
+ */
+extern int isCheckpointValid(char* image);
+
+/**
+ * Called after a VM that was asked to checkpoint has gone away.  If
+ * it left a checkpoint in the image, the image is marked as valid.
+ *
+ * Returns 1 if the image can now be restored from.
+ */
+extern int completeCheckpoint(char* image);
+
+/**
+ * Delete the contents of the image and make sure the (empty)
+ * image directory exists so that a new checkpoint can be written.
+ *
+ * Returns 0 if success.
+ */
+extern int resetCheckpoint(char* image);
+
+#endif /* ECLIPSE_CHECKPOINT_H */
@@ -25,6 +25,7 @@
 #include <string.h>
 #include <dirent.h>
 #include <limits.h>
+#include <pthread.h>
 #endif
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,10 +46,6 @@ _TCHAR* osArchArg    = _T_ECLIPSE(DEFAULT_OS_ARCH);
 #endif
 _TCHAR* wsArg        = _T_ECLIPSE(DEFAULT_WS);	/* the SWT supported GUI to be used */
 
-/* Local Variables */
-static _TCHAR* filterPrefix = NULL;  /* prefix for the find files filter */
-static size_t  prefixLength = 0;
-
 static int isFolder(const _TCHAR* path, const _TCHAR* entry);
 
 typedef struct {
@@ -349,16 +346,7 @@ char * resolveSymlinks( char * path ) {
 }
 #endif
 
-#ifdef _WIN32
-static int filter(_TCHAR* candidate, int isFolder) {
-#else
-#ifdef MACOSX
-static int filter(struct dirent *dir, int isFolder) {
-#else
-static int filter(const struct dirent *dir, int isFolder) {
-#endif
-	char * candidate = (char *)dir->d_name;
-#endif
+static int filter(_TCHAR* candidate, int isFolder, _TCHAR* filterPrefix, size_t prefixLength) {
 	_TCHAR *lastDot, *lastUnderscore;
 	int result;
 	
@@ -394,6 +382,91 @@ static int filter(const struct dirent *dir, int isFolder) {
 	return result;
 }
 
+#ifndef _WIN32
+/* 
+ * The sorted entries of the directory findFile last searched.  The launcher looks for
+ * several bundles in the same plugins directory; on a large install reading it once
+ * and doing a binary search per prefix is much cheaper than a readdir per prefix.
+ * The launcher looks for the startup jar and the splash on threads of their own,
+ * dirIndexLock guards the index.
+ */
+static struct {
+	_TCHAR*  path;
+	time_t   modified;
+	_TCHAR** entries;
+	int      count;
+} dirIndex = { NULL, 0, NULL, 0 };
+static pthread_mutex_t dirIndexLock = PTHREAD_MUTEX_INITIALIZER;
+
+static int compareEntries(const void* a, const void* b) {
+	return _tcscmp(*(_TCHAR* const*) a, *(_TCHAR* const*) b);
+}
+
+/* caller holds dirIndexLock */
+static void dropIndex() {
+	while (dirIndex.count > 0)
+		free(dirIndex.entries[--dirIndex.count]);
+	if (dirIndex.entries != NULL)
+		free(dirIndex.entries);
+	if (dirIndex.path != NULL)
+		free(dirIndex.path);
+	dirIndex.entries = NULL;
+	dirIndex.path = NULL;
+}
+
+static int indexDirectory(_TCHAR* path, struct _stat* stats) {
+	DIR *dir;
+	struct dirent * entry;
+	int size = 256;
+
+	if (dirIndex.path != NULL && _tcscmp(dirIndex.path, path) == 0 && dirIndex.modified == stats->st_mtime)
+		return 1;
+
+	dropIndex();
+
+	if ((dir = opendir(path)) == NULL)
+		return 0;
+
+	dirIndex.entries = malloc(size * sizeof(_TCHAR*));
+	while ((entry = readdir(dir)) != NULL) {
+		if (entry->d_name[0] == _T_ECLIPSE('.'))
+			continue;
+		if (dirIndex.count == size) {
+			size *= 2;
+			dirIndex.entries = realloc(dirIndex.entries, size * sizeof(_TCHAR*));
+		}
+		dirIndex.entries[dirIndex.count++] = _tcsdup(entry->d_name);
+	}
+	closedir(dir);
+
+	qsort(dirIndex.entries, dirIndex.count, sizeof(_TCHAR*), compareEntries);
+	dirIndex.path = _tcsdup(path);
+	dirIndex.modified = stats->st_mtime;
+	return 1;
+}
+
+/* index of the first entry not sorting before prefix */
+static int lowerBound(_TCHAR* prefix) {
+	int low = 0, high = dirIndex.count;
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (_tcscmp(dirIndex.entries[middle], prefix) < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+#endif
+
+void freeFileIndex() {
+#ifndef _WIN32
+	pthread_mutex_lock(&dirIndexLock);
+	dropIndex();
+	pthread_mutex_unlock(&dirIndexLock);
+#endif
+}
+
  /* 
  * Looks for files of the form /path/prefix_version.<extension> and returns the full path to
  * the file with the largest version number
@@ -409,10 +482,10 @@ _TCHAR* findFile( _TCHAR* path, _TCHAR* prefix)
 	_TCHAR* fileName = NULL;
 	WIN32_FIND_DATA data;
 	HANDLE handle;
-#else	
-	DIR *dir = NULL;
-	struct dirent * entry = NULL;
+#else
+	int i;
 #endif
+	size_t prefixLength;
 	
 	path = _tcsdup(path);
 	pathLength = _tcslen(path);
@@ -428,7 +501,6 @@ _TCHAR* findFile( _TCHAR* path, _TCHAR* prefix)
 		return NULL;
 	}
 	
-	filterPrefix = prefix;
 	prefixLength = _tcslen(prefix);
 #ifdef _WIN32
 	fileName = malloc( (_tcslen(path) + 1 + _tcslen(prefix) + 3) * sizeof(_TCHAR));
@@ -436,10 +508,10 @@ _TCHAR* findFile( _TCHAR* path, _TCHAR* prefix)
 	
 	handle = FindFirstFile(fileName, &data);
 	if(handle != INVALID_HANDLE_VALUE) {
-		if (filter(data.cFileName, isFolder(path, data.cFileName)))
+		if (filter(data.cFileName, isFolder(path, data.cFileName), prefix, prefixLength))
 			candidate = _tcsdup(data.cFileName);
 		while(FindNextFile(handle, &data) != 0) {
-			if (filter(data.cFileName, isFolder(path, data.cFileName))) {
+			if (filter(data.cFileName, isFolder(path, data.cFileName), prefix, prefixLength)) {
 				if (candidate == NULL) {
 					candidate = _tcsdup(data.cFileName);
 				} else if( compareVersions(candidate + prefixLength + 1, data.cFileName + prefixLength + 1) < 0) {
@@ -452,22 +524,27 @@ _TCHAR* findFile( _TCHAR* path, _TCHAR* prefix)
 		FindClose(handle);
 	}
 #else
-	if ((dir = opendir(path)) == NULL) {
+	pthread_mutex_lock(&dirIndexLock);
+	if (!indexDirectory(path, &stats)) {
+		pthread_mutex_unlock(&dirIndexLock);
 		free(path);
 		return NULL;
 	}
 
-	while ((entry = readdir(dir)) != NULL) {
-		if (filter(entry, isFolder(path, entry->d_name))) {
+	/* the index is sorted, all candidates follow the first entry starting with the prefix */
+	for (i = lowerBound(prefix); i < dirIndex.count && _tcsncmp(dirIndex.entries[i], prefix, prefixLength) == 0; i++) {
+		_TCHAR* entry = dirIndex.entries[i];
+		if (filter(entry, isFolder(path, entry), prefix, prefixLength)) {
 			if (candidate == NULL) {
-				candidate = _tcsdup(entry->d_name);
-			} else if (compareVersions(candidate + prefixLength + 1, entry->d_name + prefixLength + 1) < 0) {
-				free(candidate);
-				candidate = _tcsdup(entry->d_name);
+				candidate = entry;
+			} else if (compareVersions(candidate + prefixLength + 1, entry + prefixLength + 1) < 0) {
+				candidate = entry;
 			}
 		}
 	}
-	closedir(dir);
+	if (candidate != NULL)
+		candidate = _tcsdup(candidate);
+	pthread_mutex_unlock(&dirIndexLock);
 #endif
 
 	if(candidate != NULL) {
@@ -31,8 +31,10 @@
 #define RUN_METHOD 		 _T_ECLIPSE("run")
 #define SET_INITIAL_ARGS _T_ECLIPSE("setInitialArgs")
 #endif
+#define SET_EMBEDDED_INI _T_ECLIPSE("setEmbeddedIni")
 
 #define DEFAULT_EQUINOX_STARTUP _T_ECLIPSE("org.eclipse.equinox.launcher")
+#define OSGI_FRAMEWORK			_T_ECLIPSE("org.eclipse.osgi")
 
 #ifdef _WIN32
 #define IS_ABSOLUTE(path) (path[0] == _T_ECLIPSE('/') || path[0] == _T_ECLIPSE('\\') || (path[0] != 0 && path[1] == _T_ECLIPSE(':')))
@@ -67,6 +69,11 @@ extern _TCHAR* findSymlinkCommand( _TCHAR* command, int resolve );
 
 extern _TCHAR* findFile( _TCHAR* path, _TCHAR* prefix);
 
+/*
+ * Frees the directory index findFile keeps between calls, a later call reads the directory again
+ */
+extern void freeFileIndex();
+
 extern _TCHAR* getProgramDir();
 
 extern _TCHAR* getOfficialName();
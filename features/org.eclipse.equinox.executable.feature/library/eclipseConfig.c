@@ -101,16 +101,53 @@ _TCHAR* getIniFile(_TCHAR* program, int consoleLauncher){
 	return config_file;
 }
 
+/* Add a line of a configuration file to argv, unless it is a comment or empty */
+static void addConfigArg( _TCHAR * argument, _TCHAR ***argv, int *index, int *maxArgs )
+{
+	_TCHAR * arg;
+	size_t length;
+
+	/* watch for comments */
+	if(argument[0] == _T_ECLIPSE('#'))
+		return;
+
+	arg = _tcsdup(argument);
+	length = _tcslen(arg);
+	
+	/* basic whitespace trimming */
+	while (length > 0 && (arg[length - 1] == _T_ECLIPSE(' ')  || 
+			              arg[length - 1] == _T_ECLIPSE('\t') || 
+			              arg[length - 1] == _T_ECLIPSE('\r'))) 
+	{
+		arg[--length] = 0;
+	}
+	/* ignore empty lines */
+	if (length == 0) {
+		free(arg);
+		return;
+	}
+	
+	(*argv)[*index] = arg;
+	(*index)++;
+	
+	/* Grow the array of TCHAR*. Ensure one more entry is
+	 * available for the final NULL entry
+	 */
+	if (*index == *maxArgs - 1)
+	{
+		*maxArgs += 128;
+		*argv = (_TCHAR **)realloc(*argv, *maxArgs * sizeof(_TCHAR*));
+	}
+}
+
 int readConfigFile( _TCHAR * config_file, int *argc, _TCHAR ***argv )
 {
 	_TCHAR * buffer;
 	_TCHAR * argument;
-	_TCHAR * arg;
 	FILE *file = NULL;
 	int maxArgs = 128;
 	int index;
 	size_t bufferSize = 1024;
-	size_t length;
 	
 	
 	/* Open the config file as a text file 
@@ -149,37 +186,7 @@ int readConfigFile( _TCHAR * config_file, int *argc, _TCHAR ***argv )
 		 */
 		if (_stscanf(buffer, _T_ECLIPSE("%[^\n]"), argument) == 1)
 		{
-			/* watch for comments */
-			if(argument[0] == _T_ECLIPSE('#'))
-				continue;
-
-			arg = _tcsdup(argument);
-			length = _tcslen(arg);
-			
-			/* basic whitespace trimming */
-			while (length > 0 && (arg[length - 1] == _T_ECLIPSE(' ')  || 
-					              arg[length - 1] == _T_ECLIPSE('\t') || 
-					              arg[length - 1] == _T_ECLIPSE('\r'))) 
-			{
-				arg[--length] = 0;
-			}
-			/* ignore empty lines */
-			if (length == 0) {
-				free(arg);
-				continue;
-			}
-			
-			(*argv)[index] = arg;
-			index++;
-			
-			/* Grow the array of TCHAR*. Ensure one more entry is
-			 * available for the final NULL entry
-			 */
-			if (index == maxArgs - 1)
-			{
-				maxArgs += 128;
-				*argv = (_TCHAR **)realloc(*argv, maxArgs * sizeof(_TCHAR*));
-			}
+			addConfigArg(argument, argv, &index, &maxArgs);
 		}
 	}
 	(*argv)[index] = NULL;
@@ -191,6 +198,33 @@ int readConfigFile( _TCHAR * config_file, int *argc, _TCHAR ***argv )
 	return 0;
 }
 
+int readConfigData( _TCHAR * data, int *argc, _TCHAR ***argv )
+{
+	_TCHAR * argument;
+	_TCHAR * end;
+	int maxArgs = 128;
+	int index = 0;
+	size_t length;
+
+	*argv = (_TCHAR **)malloc((1 + maxArgs) * sizeof(_TCHAR*));
+	while (*data != 0)
+	{
+		end = _tcschr(data, _T_ECLIPSE('\n'));
+		length = (end != NULL) ? (size_t)(end - data) : _tcslen(data);
+
+		argument = (_TCHAR*)malloc((length + 1) * sizeof(_TCHAR));
+		memcpy(argument, data, length * sizeof(_TCHAR));
+		argument[length] = 0;
+		addConfigArg(argument, argv, &index, &maxArgs);
+		free(argument);
+
+		data += (end != NULL) ? length + 1 : length;
+	}
+	(*argv)[index] = NULL;
+	*argc = index;
+	return 0;
+}
+
 void freeConfig(_TCHAR **argv) 
 {
 	int index = 0;
@@ -57,6 +57,14 @@ extern _TCHAR* getIniFile(_TCHAR* program, int consoleLauncher);
  * Returns 0 if success.
  */
 extern int readConfigFile( _TCHAR * config_file, int *argc, _TCHAR ***argv );
+
+/**
+ * Reads the arguments from data, which holds the content of a
+ * configuration file, like readConfigFile() does from the file.
+ *
+ * Returns 0 if success.
+ */
+extern int readConfigData( _TCHAR * data, int *argc, _TCHAR ***argv );
 /**
  * Free the memory allocated by readConfigFile().
  */
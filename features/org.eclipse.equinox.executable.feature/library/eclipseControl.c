@@ -0,0 +1,346 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Control channel of an exec'd VM
+ *
+ * A VM the launcher runs in its own process reaches the splash and the exit
+ * data through the JNIBridge natives.  An exec'd VM would have to load the
+ * launcher library and GTK itself to draw its own splash, and could only
+ * return exit data through shared memory.  Instead the VM inherits the write
+ * end of a pipe, and JNIBridge sends its calls to the launcher as lines:
+ *
+ *   splash <bitmap>
+ *   progress <done> <total> <label>
+ *   hidesplash
+ *   takedown
+ *   exitdata <data>
+ *   openfiles
+ *   taken
+ *   refused
+ *
+ * A splash handler of SWT needs the handle of a splash window in its own
+ * process, so the VM still shows the splash itself when it can load the
+ * launcher library, and sends hidesplash to have the launcher take down the
+ * one it showed while the VM started.  takedown ends the startup either way.
+ *
+ * with backslash, newline and carriage return escaped as \\, \n and \r.
+ * Java can't use an inherited socket without native code, but it can open
+ * /proc/self/fd/<n> of a pipe.  The launcher keeps the write end open, so
+ * the VMs of a restart reuse the channel, and serves it while it waits for
+ * the VM (see launchJavaVM).
+ *
+ * A second pipe goes the other way, for the files other launchers hand to
+ * this instance (see eclipseHandoff.c).  Once the VM sent openfiles, it reads
+ *
+ *   open <file>
+ *
+ * lines from it, and answers each with taken once the application took the
+ * file, or refused if nothing did in time.  A handoff only succeeds if all
+ * its files were taken, the launcher that handed them over reports them
+ * otherwise.  The write end is non-blocking: a VM that stops reading makes
+ * the handoff fail rather than the thread that serves it hang.
+ */
+
+#include "eclipseOS.h"
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipseControl.h"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CONTROL_CHUNK		4096
+#define MAX_CONTROL_LINE	(1024 * 1024)
+#define FILE_REPLY_TIMEOUT	4		/* seconds to wait for taken or refused, the VM waits 3 */
+
+static int   controlPipe[2] = { -1, -1 };	/* VM -> launcher */
+static char  controlPath[32];
+static char* buffer = NULL;
+static size_t bufferLength = 0;
+static size_t bufferSize = 0;
+static int   skipLine = 0;					/* the rest of a line that was too long */
+static char* controlExitData = NULL;
+
+static int   filesPipe[2] = { -1, -1 };		/* launcher -> VM */
+static char  filesPath[32];
+static int   filesAccepted = 0;				/* the running VM reads filesPipe */
+static int   fileReply = -1;				/* the answer to the last file, 1 taken, 0 refused */
+static pthread_mutex_t filesLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  fileReplied = PTHREAD_COND_INITIALIZER;
+
+int startControlChannel() {
+	if (controlPipe[0] >= 0)
+		return 0;
+	if (pipe(controlPipe) != 0)
+		return -1;
+	/* only the VM gets the write end */
+	fcntl(controlPipe[0], F_SETFD, FD_CLOEXEC);
+	fcntl(controlPipe[0], F_SETFL, fcntl(controlPipe[0], F_GETFL) | O_NONBLOCK);
+	sprintf(controlPath, "/proc/self/fd/%d", controlPipe[1]);
+
+	/* the files go without the channel for them if there is no pipe */
+	if (pipe(filesPipe) == 0) {
+		fcntl(filesPipe[1], F_SETFD, FD_CLOEXEC);
+		fcntl(filesPipe[1], F_SETFL, fcntl(filesPipe[1], F_GETFL) | O_NONBLOCK);
+		sprintf(filesPath, "/proc/self/fd/%d", filesPipe[0]);
+	} else {
+		filesPipe[0] = filesPipe[1] = -1;
+	}
+	return 0;
+}
+
+char* getControlPath() {
+	return (controlPipe[0] >= 0) ? controlPath : NULL;
+}
+
+int getControlFd() {
+	return controlPipe[0];
+}
+
+char* getControlFilesPath() {
+	return (filesPipe[0] >= 0) ? filesPath : NULL;
+}
+
+static void acceptFiles(int accept) {
+	pthread_mutex_lock(&filesLock);
+	filesAccepted = accept;
+	/* a handoff waiting for the VM that went away gives up */
+	pthread_cond_broadcast(&fileReplied);
+	pthread_mutex_unlock(&filesLock);
+}
+
+static void replyFile(int taken) {
+	pthread_mutex_lock(&filesLock);
+	fileReply = taken;
+	pthread_cond_broadcast(&fileReplied);
+	pthread_mutex_unlock(&filesLock);
+}
+
+/* Wait for the answer to the file just sent, filesLock is held */
+static int waitForReply() {
+	struct timespec deadline;
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += FILE_REPLY_TIMEOUT;
+	while (fileReply == -1 && filesAccepted) {
+		if (pthread_cond_timedwait(&fileReplied, &filesLock, &deadline) == ETIMEDOUT)
+			break;
+	}
+	if (fileReply == -1) {
+		/* a late answer could be taken for the one to the next file */
+		filesAccepted = 0;
+		return 0;
+	}
+	return fileReply;
+}
+
+/* Write "open <file>" escaped to line, returns its length */
+static size_t formatOpen(char* line, const char* file) {
+	size_t length = sprintf(line, "open ");
+	for (; *file != 0; file++) {
+		if (*file == '\\' || *file == '\n' || *file == '\r')
+			line[length++] = '\\';
+		line[length++] = (*file == '\n') ? 'n' : (*file == '\r') ? 'r' : *file;
+	}
+	line[length++] = '\n';
+	return length;
+}
+
+int sendControlFiles(char* files[]) {
+	char* line;
+	size_t length;
+	ssize_t written;
+	int result, i;
+
+	pthread_mutex_lock(&filesLock);
+	result = filesAccepted && filesPipe[1] >= 0;
+	for (i = 0; result && files[i] != NULL; i++) {
+		line = malloc(2 * strlen(files[i]) + 7);
+		length = formatOpen(line, files[i]);
+		fileReply = -1;
+		do {
+			written = write(filesPipe[1], line, length);
+		} while (written < 0 && errno == EINTR);
+		free(line);
+		if (written != (ssize_t) length) {
+			/* the VM would read the rest of the line as the start of the next one */
+			if (written > 0)
+				filesAccepted = 0;
+			result = 0;
+		} else {
+			result = waitForReply();
+		}
+	}
+	pthread_mutex_unlock(&filesLock);
+	return result;
+}
+
+static void unescape(char* line) {
+	char* in = line;
+	char* out = line;
+
+	while (*in != 0) {
+		if (*in == '\\' && in[1] != 0) {
+			in++;
+			*out++ = (*in == 'n') ? '\n' : (*in == 'r') ? '\r' : *in;
+			in++;
+		} else {
+			*out++ = *in++;
+		}
+	}
+	*out = 0;
+}
+
+static void handleMessage(char* line) {
+	char* argument = strchr(line, ' ');
+	int done, total, offset = 0;
+
+	if (argument != NULL)
+		*argument++ = 0;
+	else
+		argument = line + strlen(line);
+	unescape(argument);
+
+	if (strcmp(line, "splash") == 0) {
+		if (*argument != 0)
+			showSplash(argument);
+	} else if (strcmp(line, "progress") == 0) {
+		if (sscanf(argument, "%d %d %n", &done, &total, &offset) >= 2)
+			updateSplashProgress(done, total, argument[offset] != 0 ? argument + offset : NULL);
+	} else if (strcmp(line, "hidesplash") == 0) {
+		takeDownSplash();
+	} else if (strcmp(line, "takedown") == 0) {
+		takeDownSplash();
+		controlStartupComplete();
+	} else if (strcmp(line, "exitdata") == 0) {
+		if (controlExitData != NULL)
+			free(controlExitData);
+		controlExitData = strdup(argument);
+	} else if (strcmp(line, "openfiles") == 0) {
+		acceptFiles(1);
+	} else if (strcmp(line, "taken") == 0) {
+		replyFile(1);
+	} else if (strcmp(line, "refused") == 0) {
+		replyFile(0);
+	}
+}
+
+/* Read what is in the pipe and handle the complete lines, returns 0 if it was empty */
+static int readControl() {
+	ssize_t count;
+	char* line;
+	char* end;
+	int result = 0;
+
+	for (;;) {
+		if (bufferSize - bufferLength < CONTROL_CHUNK + 1) {
+			bufferSize = bufferLength + CONTROL_CHUNK + 1;
+			buffer = realloc(buffer, bufferSize);
+		}
+		count = read(controlPipe[0], buffer + bufferLength, CONTROL_CHUNK);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			break;
+		result = 1;
+		bufferLength += count;
+		buffer[bufferLength] = 0;
+
+		line = buffer;
+		while ((end = memchr(line, '\n', bufferLength - (line - buffer))) != NULL) {
+			*end = 0;
+			if (!skipLine)
+				handleMessage(line);
+			skipLine = 0;
+			line = end + 1;
+		}
+		bufferLength -= line - buffer;
+		memmove(buffer, line, bufferLength);
+		if (bufferLength > MAX_CONTROL_LINE) {
+			bufferLength = 0;
+			skipLine = 1;
+		}
+	}
+	return result;
+}
+
+int serveControl(int process, int timeout) {
+	struct pollfd fds;
+	siginfo_t info;
+
+	if (controlPipe[0] < 0)
+		return 0;
+
+	/* the pipe stays open for the next VM, a VM that is gone is not waited for */
+	info.si_pid = 0;
+	if (waitid(P_PID, (id_t) process, &info, WEXITED | WNOHANG | WNOWAIT) != 0 || info.si_pid == 0) {
+		fds.fd = controlPipe[0];
+		fds.events = POLLIN;
+		fds.revents = 0;
+		if (poll(&fds, 1, timeout) > 0)
+			readControl();
+		info.si_pid = 0;
+		waitid(P_PID, (id_t) process, &info, WEXITED | WNOHANG | WNOWAIT);
+	}
+
+	/* what the VM sent last is read before it is waited for */
+	if (info.si_pid != 0) {
+		readControl();
+		/* the VM of a restart asks again */
+		acceptFiles(0);
+		return 0;
+	}
+	return 1;
+}
+
+char* takeControlExitData() {
+	char* result;
+
+	if (controlPipe[0] >= 0)
+		readControl();
+	result = controlExitData;
+	controlExitData = NULL;
+	return result;
+}
+
+void stopControlChannel() {
+	if (controlPipe[0] >= 0) {
+		close(controlPipe[0]);
+		close(controlPipe[1]);
+		controlPipe[0] = controlPipe[1] = -1;
+	}
+	pthread_mutex_lock(&filesLock);
+	if (filesPipe[0] >= 0) {
+		close(filesPipe[0]);
+		close(filesPipe[1]);
+		filesPipe[0] = filesPipe[1] = -1;
+	}
+	filesAccepted = 0;
+	pthread_mutex_unlock(&filesLock);
+	free(buffer);
+	buffer = NULL;
+	bufferLength = bufferSize = 0;
+	if (controlExitData != NULL)
+		free(controlExitData);
+	controlExitData = NULL;
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_CONTROL_H
+#define ECLIPSE_CONTROL_H
+
+/* Control channel of an exec'd VM, Linux only */
+
+/**
+ * Create the channel the VMs started afterwards inherit.  Returns 0 if
+ * success.
+ */
+extern int startControlChannel();
+
+/**
+ * The path the VM opens to write to the channel, for the
+ * eclipse.launcher.control property.  NULL if there is no channel.
+ */
+extern char* getControlPath();
+
+/**
+ * The descriptor the channel is read from, to wait for it together with
+ * others.  -1 if there is no channel.
+ */
+extern int getControlFd();
+
+/**
+ * The path the VM opens to read the files handed to this instance, for the
+ * eclipse.launcher.control.files property.  NULL if there is none.
+ */
+extern char* getControlFilesPath();
+
+/**
+ * Pass the NULL terminated list of files to the running VM, may be called
+ * from any thread but the one calling serveControl().  Returns 1 once the
+ * application took them all, 0 if the VM did not ask for files, or nothing
+ * in it took one in time.
+ */
+extern int sendControlFiles(char* files[]);
+
+/**
+ * Handle what the VM sent, waiting up to timeout milliseconds for it.
+ * Returns 0 once the process has terminated (it is left to be waited
+ * for), or if there is no channel, 1 otherwise.
+ */
+extern int serveControl(int process, int timeout);
+
+/**
+ * The exit data the VM sent since the last call, NULL if none.  To be
+ * freed by the caller.
+ */
+extern char* takeControlExitData();
+
+/**
+ * Close the channel.
+ */
+extern void stopControlChannel();
+
+#endif /* ECLIPSE_CONTROL_H */
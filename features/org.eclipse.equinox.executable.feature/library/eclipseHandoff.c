@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Single instance handoff of --launcher.openFile over a Unix socket
+ *
+ * Handing files to a running eclipse through reuseWorkbench() means loading
+ * GTK and talking to the session bus, which takes a while and is not possible
+ * at all without a session bus.  The launcher of a running instance therefore
+ * also listens on a socket in $XDG_RUNTIME_DIR, named after its workspace.
+ * A new launcher sends it the files and exits as soon as they are taken.
+ * Only instances that open files listen, and they pass them to SWT or to an
+ * exec'd VM through its control channel (see startHandoff in eclipse.c).
+ *
+ * The files are sent as NUL terminated strings ending with an empty one, the
+ * instance answers with one byte, '1' if it opened them.
+ */
+
+#define _GNU_SOURCE		/* accept4, struct ucred */
+
+#include "eclipseHandoff.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_HANDOFF_LENGTH	(256 * 1024)
+#define HANDOFF_TIMEOUT		10		/* seconds a new launcher waits for the answer */
+
+typedef int (*OpenFiles)(char* files[]);
+
+static int   listenSocket = -1;
+static char* listenPath = NULL;
+
+static int connectTo(char* socketPath) {
+	struct sockaddr_un address;
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -1;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+	if (connect(fd, (struct sockaddr*) &address, sizeof(address)) != 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static int writeFully(int fd, const char* data, size_t length) {
+	while (length > 0) {
+		ssize_t written = write(fd, data, length);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return -1;
+		data += written;
+		length -= written;
+	}
+	return 0;
+}
+
+char* getHandoffSocket(char* key) {
+	unsigned long hash = 5381;
+	char* runtimeDir = getenv("XDG_RUNTIME_DIR");
+	char* result;
+	char* c;
+
+	if (runtimeDir == NULL || runtimeDir[0] == 0)
+		return NULL;
+	if (strlen(runtimeDir) + 32 > sizeof(((struct sockaddr_un*) 0)->sun_path))
+		return NULL;
+	for (c = key; *c != 0; c++)
+		hash = hash * 33 + (unsigned char) *c;
+	result = malloc(strlen(runtimeDir) + 32);
+	sprintf(result, "%s/eclipse-%08lx.sock", runtimeDir, hash & 0xffffffffUL);
+	return result;
+}
+
+int handOffFiles(char* socketPath, char* files[]) {
+	struct timeval timeout = { HANDOFF_TIMEOUT, 0 };
+	char cwd[PATH_MAX];
+	char answer = 0;
+	int fd, i, ok = 0;
+
+	if ((fd = connectTo(socketPath)) < 0)
+		return 0;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	if (getcwd(cwd, sizeof(cwd)) == NULL)
+		cwd[0] = 0;
+	for (i = 0; files[i] != NULL; i++) {
+		/* the instance has its own working directory */
+		if (files[i][0] != '/' && cwd[0] != 0 && (writeFully(fd, cwd, strlen(cwd)) != 0 || writeFully(fd, "/", 1) != 0))
+			break;
+		if (writeFully(fd, files[i], strlen(files[i]) + 1) != 0)
+			break;
+	}
+	if (files[i] == NULL && writeFully(fd, "", 1) == 0) {
+		shutdown(fd, SHUT_WR);
+		ok = (read(fd, &answer, 1) == 1 && answer == '1');
+	}
+	close(fd);
+	return ok;
+}
+
+static void handOver(int fd, OpenFiles openFiles) {
+	char* data = malloc(MAX_HANDOFF_LENGTH);
+	char** files;
+	size_t length = 0;
+	ssize_t count;
+	int i, n = 0;
+	char answer;
+
+#ifdef SO_PEERCRED
+	{
+		/* the runtime directory is private, but don't take files from other users anyway */
+		struct ucred credentials;
+		socklen_t size = sizeof(credentials);
+		if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0 || credentials.uid != getuid()) {
+			free(data);
+			return;
+		}
+	}
+#endif
+	while (length < MAX_HANDOFF_LENGTH && (count = read(fd, data + length, MAX_HANDOFF_LENGTH - length)) != 0) {
+		if (count < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		length += count;
+		/* done at the empty string */
+		if (length >= 2 && data[length - 1] == 0 && data[length - 2] == 0)
+			break;
+	}
+	if (length < 2 || data[length - 1] != 0 || data[length - 2] != 0) {
+		free(data);
+		return;
+	}
+
+	for (i = 0; i < (int) length - 1; i += strlen(data + i) + 1)
+		n++;
+	files = malloc((n + 1) * sizeof(char*));
+	for (i = 0, n = 0; i < (int) length - 1; i += strlen(data + i) + 1)
+		files[n++] = data + i;
+	files[n] = NULL;
+
+	answer = (n > 0 && openFiles(files)) ? '1' : '0';
+	writeFully(fd, &answer, 1);
+	free(files);
+	free(data);
+}
+
+typedef struct {
+	int fd;
+	OpenFiles openFiles;
+} HandoffArgs;
+
+static void * handoffThread(void * init) {
+	HandoffArgs* args = (HandoffArgs*) init;
+	int fd;
+
+	while ((fd = accept4(args->fd, NULL, NULL, SOCK_CLOEXEC)) >= 0 || errno == EINTR || errno == ECONNABORTED) {
+		if (fd < 0)
+			continue;
+		handOver(fd, args->openFiles);
+		close(fd);
+	}
+	/* stopHandoff() shut the socket down */
+	close(args->fd);
+	free(args);
+	return NULL;
+}
+
+int listenForHandoff(char* socketPath, OpenFiles openFiles) {
+	struct sockaddr_un address;
+	HandoffArgs* args;
+	pthread_t thread;
+	pthread_attr_t attributes;
+	int fd;
+
+	if (listenSocket >= 0)
+		return 1;
+	if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0)
+		return 0;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+	if (bind(fd, (struct sockaddr*) &address, sizeof(address)) != 0) {
+		int inUse = (errno == EADDRINUSE);
+		int other = inUse ? connectTo(socketPath) : -1;
+		if (other >= 0)
+			close(other);
+		/* unless it was left behind by an instance that crashed, another instance is listening */
+		if (!inUse || other >= 0 || unlink(socketPath) != 0 || bind(fd, (struct sockaddr*) &address, sizeof(address)) != 0) {
+			close(fd);
+			return 0;
+		}
+	}
+	if (listen(fd, 8) != 0) {
+		close(fd);
+		unlink(socketPath);
+		return 0;
+	}
+
+	args = malloc(sizeof(HandoffArgs));
+	args->fd = fd;
+	args->openFiles = openFiles;
+	pthread_attr_init(&attributes);
+	pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&thread, &attributes, handoffThread, args) != 0) {
+		free(args);
+		close(fd);
+		unlink(socketPath);
+		pthread_attr_destroy(&attributes);
+		return 0;
+	}
+	pthread_attr_destroy(&attributes);
+	listenSocket = fd;
+	listenPath = strdup(socketPath);
+	return 1;
+}
+
+void stopHandoff() {
+	if (listenSocket < 0)
+		return;
+	unlink(listenPath);
+	shutdown(listenSocket, SHUT_RDWR);
+	listenSocket = -1;
+	free(listenPath);
+	listenPath = NULL;
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_HANDOFF_H
+#define ECLIPSE_HANDOFF_H
+
+/* Single instance handoff of --launcher.openFile over a Unix socket, Linux only */
+
+/**
+ * Returns the socket of the instance identified by key (its workspace, or
+ * its installation), in $XDG_RUNTIME_DIR.  Returns NULL if there is no
+ * runtime directory.  The result must be freed with free().
+ */
+extern char* getHandoffSocket(char* key);
+
+/**
+ * Hand the NULL terminated list of files to the instance listening on
+ * socketPath.  Relative paths are made absolute first.
+ * Returns 1 if that instance opened them, 0 otherwise.
+ */
+extern int handOffFiles(char* socketPath, char* files[]);
+
+/**
+ * Start a background thread that listens on socketPath and passes the
+ * files handed over by other launchers to openFiles, which returns 1 if
+ * they were opened.  Returns 0 if another live instance owns the socket.
+ */
+extern int listenForHandoff(char* socketPath, int (*openFiles)(char* files[]));
+
+/**
+ * Stop listening and remove the socket.
+ */
+extern void stopHandoff();
+
+#endif /* ECLIPSE_HANDOFF_H */
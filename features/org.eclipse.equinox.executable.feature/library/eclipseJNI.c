@@ -20,6 +20,19 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <strings.h>
+#include <langinfo.h>
+#endif
+
+/* strings up to this size are converted to modified UTF-8 on the stack */
+#define MAX_UTF_STACK 1024
+/* local refs per frame when creating the program arguments */
+#define RUN_ARGS_FRAME 64
 
 
 static _TCHAR* failedToLoadLibrary = _T_ECLIPSE("Failed to load the JNI shared library \"%s\".\n");
@@ -29,30 +42,37 @@ static _TCHAR* internalExpectedVMArgs = _T_ECLIPSE("Internal Error, the JVM argu
 static _TCHAR* mainClassNotFound = _T_ECLIPSE("Failed to find a Main Class in \"%s\".\n");
 
 static JNINativeMethod natives[] = {{"_update_splash", "()V", (void *)&update_splash},
+									{"_update_splash_progress", "(IILjava/lang/String;)V", (void *)&update_splash_progress},
 									{"_get_splash_handle", "()J", (void *)&get_splash_handle},
 									{"_set_exit_data", "(Ljava/lang/String;Ljava/lang/String;)V", (void *)&set_exit_data},
 									{"_set_launcher_info", "(Ljava/lang/String;Ljava/lang/String;)V", (void *)&set_launcher_info},
 									{"_show_splash", "(Ljava/lang/String;)V", (void *)&show_splash},
 									{"_takedown_splash", "()V", (void *)&takedown_splash},
-									{"_get_os_recommended_folder", "()Ljava/lang/String;", (void *)&get_os_recommended_folder}};
+									{"_get_os_recommended_folder", "()Ljava/lang/String;", (void *)&get_os_recommended_folder},
+									{"_get_framework_location", "()Ljava/lang/String;", (void *)&get_framework_location}};
 
 /* local methods */
 static jstring newJavaString(JNIEnv *env, _TCHAR * str);
+static jclass getStringClass(JNIEnv *env);
+static void releaseStringClass(JNIEnv *env);
 static void registerNatives(JNIEnv *env);
 static int shouldShutdown(JNIEnv *env);
+static void startShutdownWatchdog(int exitCode);
 static void JNI_ReleaseStringChars(JNIEnv *env, jstring s, const _TCHAR* data);
 static const _TCHAR* JNI_GetStringChars(JNIEnv *env, jstring str);
 static char * getMainClass(JNIEnv *env, _TCHAR * jarFile);
 static void setLibraryLocation(JNIEnv *env, jobject obj);
+static void stopRecording(JNIEnv *env, _TCHAR* name);
 
 static JavaVM * jvm = 0;
 static JNIEnv *env = 0;
 
 /* cache String class and methods to avoid looking them up all the time */
 static jclass string_class = NULL;
-#if !defined(UNICODE) && !defined(MACOSX)
+#ifndef UNICODE
 static jmethodID string_getBytesMethod = NULL;
 static jmethodID string_ctor = NULL;
+static int utf8Encoding = -1;
 #endif
 
 /* JNI Callback methods */
@@ -113,6 +133,21 @@ JNIEXPORT void JNICALL update_splash(JNIEnv * env, jobject obj){
 	dispatchMessages();
 }
 
+JNIEXPORT void JNICALL update_splash_progress(JNIEnv * env, jobject obj, jint done, jint total, jstring label){
+#if !defined(_WIN32) && !defined(MACOSX)
+	const _TCHAR* data = NULL;
+	
+	if (label != NULL)
+		data = JNI_GetStringChars(env, label);
+	updateSplashProgress(done, total, data);
+	if (data != NULL)
+		JNI_ReleaseStringChars(env, label, data);
+#else
+	/* the launcher draws progress on GTK only */
+	dispatchMessages();
+#endif
+}
+
 JNIEXPORT jlong JNICALL get_splash_handle(JNIEnv * env, jobject obj){
 	return getSplashHandle();
 }
@@ -136,6 +171,9 @@ JNIEXPORT void JNICALL show_splash(JNIEnv * env, jobject obj, jstring s){
 
 JNIEXPORT void JNICALL takedown_splash(JNIEnv * env, jobject obj){
 	takeDownSplash();
+	startupComplete();
+	if (startupRecording != NULL)
+		stopRecording(env, startupRecording);
 }
 
 JNIEXPORT jstring JNICALL get_os_recommended_folder(JNIEnv * env, jobject obj){
@@ -146,6 +184,146 @@ JNIEXPORT jstring JNICALL get_os_recommended_folder(JNIEnv * env, jobject obj){
 #endif
 }
 
+JNIEXPORT jstring JNICALL get_framework_location(JNIEnv * env, jobject obj){
+	if (frameworkLocation == NULL)
+		return NULL;
+	return newJavaString(env, frameworkLocation);
+}
+
+/*
+ * Stop the JFR recording started by --launcher.profileStartup, which
+ * writes it to the file given on the command line.
+ */
+static void stopRecording(JNIEnv *env, _TCHAR* name) {
+	jclass recorderClass = NULL, listClass = NULL, recordingClass = NULL;
+	jmethodID getRecorder = NULL, getRecordings = NULL, size = NULL, get = NULL, getName = NULL, stop = NULL;
+
+	/* nothing may be called with an exception pending, so one after the other */
+	recorderClass = (*env)->FindClass(env, "jdk/jfr/FlightRecorder");
+	if (recorderClass != NULL)
+		listClass = (*env)->FindClass(env, "java/util/List");
+	if (listClass != NULL)
+		recordingClass = (*env)->FindClass(env, "jdk/jfr/Recording");
+	if (recordingClass != NULL)
+		getRecorder = (*env)->GetStaticMethodID(env, recorderClass, "getFlightRecorder", "()Ljdk/jfr/FlightRecorder;");
+	if (getRecorder != NULL)
+		getRecordings = (*env)->GetMethodID(env, recorderClass, "getRecordings", "()Ljava/util/List;");
+	if (getRecordings != NULL)
+		size = (*env)->GetMethodID(env, listClass, "size", "()I");
+	if (size != NULL)
+		get = (*env)->GetMethodID(env, listClass, "get", "(I)Ljava/lang/Object;");
+	if (get != NULL)
+		getName = (*env)->GetMethodID(env, recordingClass, "getName", "()Ljava/lang/String;");
+	if (getName != NULL)
+		stop = (*env)->GetMethodID(env, recordingClass, "stop", "()Z");
+
+	if (stop != NULL) {
+		jobject recorder = NULL, recordings = NULL;
+		jint i, count = 0;
+
+		recorder = (*env)->CallStaticObjectMethod(env, recorderClass, getRecorder);
+		if (recorder != NULL && !(*env)->ExceptionCheck(env))
+			recordings = (*env)->CallObjectMethod(env, recorder, getRecordings);
+		if (recordings != NULL && !(*env)->ExceptionCheck(env))
+			count = (*env)->CallIntMethod(env, recordings, size);
+		for (i = 0; i < count && !(*env)->ExceptionCheck(env); i++) {
+			jobject recording = (*env)->CallObjectMethod(env, recordings, get, i);
+			jstring recordingName = (recording != NULL) ? (*env)->CallObjectMethod(env, recording, getName) : NULL;
+			if (recordingName != NULL && !(*env)->ExceptionCheck(env)) {
+				const _TCHAR* data = JNI_GetStringChars(env, recordingName);
+				if (data != NULL) {
+					if (_tcscmp(data, name) == 0)
+						(*env)->CallBooleanMethod(env, recording, stop);
+					JNI_ReleaseStringChars(env, recordingName, data);
+				}
+				(*env)->DeleteLocalRef(env, recordingName);
+			}
+			if (recording != NULL)
+				(*env)->DeleteLocalRef(env, recording);
+		}
+	}
+	if ((*env)->ExceptionOccurred(env)) {
+		(*env)->ExceptionDescribe(env);
+		(*env)->ExceptionClear(env);
+	}
+}
+
+/*
+ * The NativeMemoryTracking summary, what jcmd <pid> VM.native_memory summary prints,
+ * from the DiagnosticCommand MBean.  Called from the thread of a native or from the
+ * main thread, which is attached if the VM runs on a second thread.
+ */
+_TCHAR* getNativeMemorySummary() {
+	JNIEnv* localEnv = NULL;
+	jclass factoryClass = NULL, serverClass = NULL, nameClass = NULL, objectClass = NULL;
+	jmethodID getServer = NULL, nameConstructor = NULL, invoke = NULL;
+	_TCHAR* result = NULL;
+
+	if (jvm == NULL || string_class == NULL)
+		return NULL;
+	if ((*jvm)->GetEnv(jvm, (void**) &localEnv, JNI_VERSION_1_2) != JNI_OK &&
+			(*jvm)->AttachCurrentThread(jvm, (void**) &localEnv, NULL) != JNI_OK)
+		return NULL;
+	if ((*localEnv)->PushLocalFrame(localEnv, 16) != 0)
+		return NULL;
+
+	/* nothing may be called with an exception pending, so one after the other */
+	factoryClass = (*localEnv)->FindClass(localEnv, "java/lang/management/ManagementFactory");
+	if (factoryClass != NULL)
+		serverClass = (*localEnv)->FindClass(localEnv, "javax/management/MBeanServer");
+	if (serverClass != NULL)
+		nameClass = (*localEnv)->FindClass(localEnv, "javax/management/ObjectName");
+	if (nameClass != NULL)
+		objectClass = (*localEnv)->FindClass(localEnv, "java/lang/Object");
+	if (objectClass != NULL)
+		getServer = (*localEnv)->GetStaticMethodID(localEnv, factoryClass, "getPlatformMBeanServer", "()Ljavax/management/MBeanServer;");
+	if (getServer != NULL)
+		nameConstructor = (*localEnv)->GetMethodID(localEnv, nameClass, "<init>", "(Ljava/lang/String;)V");
+	if (nameConstructor != NULL)
+		invoke = (*localEnv)->GetMethodID(localEnv, serverClass, "invoke",
+				"(Ljavax/management/ObjectName;Ljava/lang/String;[Ljava/lang/Object;[Ljava/lang/String;)Ljava/lang/Object;");
+
+	if (invoke != NULL) {
+		jobject server = NULL, name = NULL, summary = NULL;
+		jobjectArray options = NULL, params = NULL, signature = NULL;
+		jstring string;
+
+		server = (*localEnv)->CallStaticObjectMethod(localEnv, factoryClass, getServer);
+		if (server != NULL && !(*localEnv)->ExceptionCheck(localEnv)) {
+			string = newJavaString(localEnv, _T_ECLIPSE("com.sun.management:type=DiagnosticCommand"));
+			if (string != NULL)
+				name = (*localEnv)->NewObject(localEnv, nameClass, nameConstructor, string);
+		}
+		/* vmNativeMemory(new String[] { "summary", "scale=KB" }) */
+		if (name != NULL && !(*localEnv)->ExceptionCheck(localEnv))
+			options = (*localEnv)->NewObjectArray(localEnv, 2, string_class, newJavaString(localEnv, _T_ECLIPSE("summary")));
+		if (options != NULL && !(*localEnv)->ExceptionCheck(localEnv)) {
+			(*localEnv)->SetObjectArrayElement(localEnv, options, 1, newJavaString(localEnv, _T_ECLIPSE("scale=KB")));
+			params = (*localEnv)->NewObjectArray(localEnv, 1, objectClass, options);
+		}
+		if (params != NULL && !(*localEnv)->ExceptionCheck(localEnv))
+			signature = (*localEnv)->NewObjectArray(localEnv, 1, string_class, newJavaString(localEnv, _T_ECLIPSE("[Ljava.lang.String;")));
+		if (signature != NULL && !(*localEnv)->ExceptionCheck(localEnv)) {
+			string = newJavaString(localEnv, _T_ECLIPSE("vmNativeMemory"));
+			if (string != NULL)
+				summary = (*localEnv)->CallObjectMethod(localEnv, server, invoke, name, string, params, signature);
+		}
+		if (summary != NULL && !(*localEnv)->ExceptionCheck(localEnv) && (*localEnv)->IsInstanceOf(localEnv, summary, string_class)) {
+			const _TCHAR* data = JNI_GetStringChars(localEnv, (jstring) summary);
+			if (data != NULL) {
+				result = _tcsdup(data);
+				JNI_ReleaseStringChars(localEnv, (jstring) summary, data);
+			}
+		}
+	}
+	if ((*localEnv)->ExceptionOccurred(localEnv)) {
+		(*localEnv)->ExceptionDescribe(localEnv);
+		(*localEnv)->ExceptionClear(localEnv);
+	}
+	(*localEnv)->PopLocalFrame(localEnv, NULL);
+	return result;
+}
+
 /*
  * On AIX we need the location of the eclipse shared library so that we
  * can find the libeclipse-motif.so library.  Reach into the JNIBridge
@@ -183,6 +361,142 @@ static void registerNatives(JNIEnv *env) {
 }
 
 
+/* The String class as a global ref, the callbacks run in frames of their own */
+static jclass getStringClass(JNIEnv *env) {
+	jclass localClass;
+	if (string_class == NULL) {
+		localClass = (*env)->FindClass(env, "java/lang/String");
+		if (localClass != NULL) {
+			string_class = (*env)->NewGlobalRef(env, localClass);
+			(*env)->DeleteLocalRef(env, localClass);
+#ifndef UNICODE
+			if (string_class != NULL) {
+				string_getBytesMethod = (*env)->GetMethodID(env, string_class, "getBytes", "()[B");
+				string_ctor = (*env)->GetMethodID(env, string_class, "<init>",  "([B)V");
+			}
+#endif
+		}
+	}
+	return string_class;
+}
+
+static void releaseStringClass(JNIEnv *env) {
+	if (string_class != NULL)
+		(*env)->DeleteGlobalRef(env, string_class);
+	string_class = NULL;
+#ifndef UNICODE
+	string_getBytesMethod = NULL;
+	string_ctor = NULL;
+#endif
+}
+
+#ifndef UNICODE
+/* Is the native encoding UTF-8, so that strings can be passed through the UTF functions of JNI
+ * instead of java's default encoding */
+static int isUTF8Encoding() {
+#if defined(MACOSX)
+	return 1;
+#elif defined(_WIN32)
+	return 0;
+#else
+	char * codeset;
+	if (utf8Encoding == -1) {
+		codeset = nl_langinfo(CODESET);
+		utf8Encoding = codeset != NULL && (strcasecmp(codeset, "UTF-8") == 0 || strcasecmp(codeset, "utf8") == 0);
+	}
+	return utf8Encoding;
+#endif
+}
+
+/* JNI uses modified UTF-8: U+0000 is C0 80 and characters above U+FFFF are two surrogates
+ * of three bytes each.  Convert it to UTF-8 in place, the result is never longer.  Unpaired
+ * surrogates become '?' like with String.getBytes(), a U+0000 ends the string.
+ */
+static void toStandardUTF8(char * str) {
+	unsigned char * in = (unsigned char *) str;
+	unsigned char * out = in;
+	unsigned int c;
+
+	while (*in != 0 && !(in[0] == 0xC0 && in[1] == 0x80)) {
+		if (in[0] != 0xED || (in[1] & 0xE0) != 0xA0) {
+			*out++ = *in++;
+		} else if ((in[1] & 0xF0) == 0xA0 && in[3] == 0xED && (in[4] & 0xF0) == 0xB0) {
+			/* high and low surrogate */
+			c = 0x10000 + ((((in[1] & 0x0F) << 6) | (in[2] & 0x3F)) << 10) + (((in[4] & 0x0F) << 6) | (in[5] & 0x3F));
+			*out++ = 0xF0 | (c >> 18);
+			*out++ = 0x80 | ((c >> 12) & 0x3F);
+			*out++ = 0x80 | ((c >> 6) & 0x3F);
+			*out++ = 0x80 | (c & 0x3F);
+			in += 6;
+		} else {
+			*out++ = '?';
+			in += 3;
+		}
+	}
+	*out = 0;
+}
+
+/* Convert UTF-8 to the modified UTF-8 NewStringUTF expects.  Returns the length of the
+ * result, -1 if str isn't valid UTF-8.  The result is written to buffer unless that is NULL.
+ */
+static int toModifiedUTF8(const char * str, char * buffer) {
+	const unsigned char * in = (const unsigned char *) str;
+	unsigned int c, surrogate[2];
+	int count, i, j, length = 0;
+
+	while (*in != 0) {
+		if (*in < 0x80) {
+			if (buffer != NULL)
+				buffer[length] = *in;
+			length++;
+			in++;
+			continue;
+		} else if (*in >= 0xC2 && *in <= 0xDF) {
+			count = 1;
+		} else if (*in >= 0xE0 && *in <= 0xEF) {
+			count = 2;
+		} else if (*in >= 0xF0 && *in <= 0xF4) {
+			count = 3;
+		} else {
+			return -1;
+		}
+		c = *in & (0x3F >> count);
+		for (i = 1; i <= count; i++) {
+			if ((in[i] & 0xC0) != 0x80)
+				return -1;
+			c = (c << 6) | (in[i] & 0x3F);
+		}
+		/* overlong forms, surrogates and beyond U+10FFFF */
+		if (count == 2 && (c < 0x800 || (c >= 0xD800 && c <= 0xDFFF)))
+			return -1;
+		if (count == 3 && (c < 0x10000 || c > 0x10FFFF))
+			return -1;
+
+		if (count < 3) {
+			if (buffer != NULL)
+				memcpy(buffer + length, in, count + 1);
+			length += count + 1;
+		} else {
+			c -= 0x10000;
+			surrogate[0] = 0xD800 | (c >> 10);
+			surrogate[1] = 0xDC00 | (c & 0x3FF);
+			for (j = 0; j < 2; j++) {
+				if (buffer != NULL) {
+					buffer[length] = (char) (0xE0 | (surrogate[j] >> 12));
+					buffer[length + 1] = (char) (0x80 | ((surrogate[j] >> 6) & 0x3F));
+					buffer[length + 2] = (char) (0x80 | (surrogate[j] & 0x3F));
+				}
+				length += 3;
+			}
+		}
+		in += count + 1;
+	}
+	if (buffer != NULL)
+		buffer[length] = 0;
+	return length;
+}
+#endif
+
 /* Get a _TCHAR* from a jstring, string should be released later with JNI_ReleaseStringChars */
 static const _TCHAR * JNI_GetStringChars(JNIEnv *env, jstring str) {
 	const _TCHAR * result = NULL;
@@ -195,27 +509,31 @@ static const _TCHAR * JNI_GetStringChars(JNIEnv *env, jstring str) {
 	copy[length] = _T_ECLIPSE('\0');
 	(*env)->ReleaseStringChars(env, str, stringChars);
 	result = copy;
-#elif MACOSX
-	/* Use UTF on the Mac */
-	result = (*env)->GetStringUTFChars(env, str, 0);
 #else
-	/* Other platforms, use java's default encoding */ 
 	_TCHAR* buffer = NULL;
-	if (string_class == NULL)
-		string_class = (*env)->FindClass(env, "java/lang/String");
-	if (string_class != NULL) {
-		if (string_getBytesMethod == NULL)
-			string_getBytesMethod = (*env)->GetMethodID(env, string_class, "getBytes", "()[B");
-		if (string_getBytesMethod != NULL) {
-			jbyteArray bytes = (*env)->CallObjectMethod(env, str, string_getBytesMethod);
-			if (!(*env)->ExceptionOccurred(env)) {
-				jsize length = (*env)->GetArrayLength(env, bytes);
-				buffer = malloc( (length + 1) * sizeof(_TCHAR*));
-				(*env)->GetByteArrayRegion(env, bytes, 0, length, (jbyte*)buffer);
-				buffer[length] = 0;
-			}
-			(*env)->DeleteLocalRef(env, bytes);
+	if (isUTF8Encoding()) {
+		/* copy the UTF straight into the result, no byte[] and no pinning */
+		jsize length = (*env)->GetStringLength(env, str);
+		jsize utfLength = (*env)->GetStringUTFLength(env, str);
+		buffer = malloc(utfLength + 1);
+		(*env)->GetStringUTFRegion(env, str, 0, length, buffer);
+		buffer[utfLength] = 0;
+		if ((*env)->ExceptionOccurred(env)) {
+			free(buffer);
+			buffer = NULL;
+		} else {
+			toStandardUTF8(buffer);
 		}
+	} else if (getStringClass(env) != NULL && string_getBytesMethod != NULL) {
+		/* Other encodings, use java's default encoding */
+		jbyteArray bytes = (*env)->CallObjectMethod(env, str, string_getBytesMethod);
+		if (!(*env)->ExceptionOccurred(env)) {
+			jsize length = (*env)->GetArrayLength(env, bytes);
+			buffer = malloc( (length + 1) * sizeof(_TCHAR*));
+			(*env)->GetByteArrayRegion(env, bytes, 0, length, (jbyte*)buffer);
+			buffer[length] = 0;
+		}
+		(*env)->DeleteLocalRef(env, bytes);
 	}
 	if(buffer == NULL) {
 		(*env)->ExceptionDescribe(env);
@@ -228,13 +546,7 @@ static const _TCHAR * JNI_GetStringChars(JNIEnv *env, jstring str) {
 
 /* Release the string that was obtained using JNI_GetStringChars */
 static void JNI_ReleaseStringChars(JNIEnv *env, jstring s, const _TCHAR* data) {
-#ifdef UNICODE
-	free((_TCHAR*)data);
-#elif MACOSX
-	(*env)->ReleaseStringUTFChars(env, s, data);
-#else
 	free((_TCHAR*)data);
-#endif
 }
 
 static jstring newJavaString(JNIEnv *env, _TCHAR * str)
@@ -243,25 +555,31 @@ static jstring newJavaString(JNIEnv *env, _TCHAR * str)
 #ifdef UNICODE
 	size_t length = _tcslen(str);
 	newString = (*env)->NewString(env, str, length);
-#elif MACOSX
-	newString = (*env)->NewStringUTF(env, str);
 #else
 	size_t length = _tcslen(str);
-	jbyteArray bytes = (*env)->NewByteArray(env, length);
-	if(bytes != NULL) {
-		(*env)->SetByteArrayRegion(env, bytes, 0, length, (jbyte *)str);
-		if (!(*env)->ExceptionOccurred(env)) {
-			if (string_class == NULL)
-				string_class = (*env)->FindClass(env, "java/lang/String");
-			if(string_class != NULL) {
-				if (string_ctor == NULL)
-					string_ctor = (*env)->GetMethodID(env, string_class, "<init>",  "([B)V");
-				if(string_ctor != NULL) {
-					newString = (*env)->NewObject(env, string_class, string_ctor, bytes);
-				}
+	char stackBuffer[MAX_UTF_STACK];
+	char * buffer;
+	int utfLength = isUTF8Encoding() ? toModifiedUTF8(str, NULL) : -1;
+	
+	if (utfLength == (int) length) {
+		/* no characters above U+FFFF, UTF-8 and modified UTF-8 are the same */
+		newString = (*env)->NewStringUTF(env, str);
+	} else if (utfLength >= 0) {
+		buffer = (utfLength < MAX_UTF_STACK) ? stackBuffer : malloc(utfLength + 1);
+		toModifiedUTF8(str, buffer);
+		newString = (*env)->NewStringUTF(env, buffer);
+		if (buffer != stackBuffer)
+			free(buffer);
+	} else if (getStringClass(env) != NULL && string_ctor != NULL) {
+		/* not UTF-8, let java's default encoding decode it */
+		jbyteArray bytes = (*env)->NewByteArray(env, length);
+		if(bytes != NULL) {
+			(*env)->SetByteArrayRegion(env, bytes, 0, length, (jbyte *)str);
+			if (!(*env)->ExceptionOccurred(env)) {
+				newString = (*env)->NewObject(env, string_class, string_ctor, bytes);
 			}
+			(*env)->DeleteLocalRef(env, bytes);
 		}
-		(*env)->DeleteLocalRef(env, bytes);
 	}
 #endif
 	if(newString == NULL) {
@@ -271,31 +589,36 @@ static jstring newJavaString(JNIEnv *env, _TCHAR * str)
 	return newString;
 }
 
+/* Create the String[] for Main.run().  The strings are created in local frames of
+ * RUN_ARGS_FRAME refs, so the VM doesn't need to grow the frame of the caller.
+ */
 static jobjectArray createRunArgs( JNIEnv *env, _TCHAR * args[] ) {
-	int index = 0, length = -1;
+	int index = 0, length = -1, end;
 	jobjectArray stringArray = NULL;
 	jstring string;
 	
 	/*count the number of elements first*/
 	while(args[++length] != NULL);
 	
-	if (string_class == NULL)
-		string_class = (*env)->FindClass(env, "java/lang/String");
-	if(string_class != NULL) {
+	if(getStringClass(env) != NULL) {
 		stringArray = (*env)->NewObjectArray(env, length, string_class, 0);
-		if(stringArray != NULL) {
-			for( index = 0; index < length; index++) {
+		while(stringArray != NULL && index < length) {
+			end = (length - index > RUN_ARGS_FRAME) ? index + RUN_ARGS_FRAME : length;
+			if ((*env)->PushLocalFrame(env, end - index) != 0)
+				break;
+			for( ; index < end; index++) {
 				string = newJavaString(env, args[index]);
-				if(string != NULL) {
-					(*env)->SetObjectArrayElement(env, stringArray, index, string); 
-					(*env)->DeleteLocalRef(env, string);
-				} else {
-					(*env)->DeleteLocalRef(env, stringArray);
-					(*env)->ExceptionDescribe(env);
-					(*env)->ExceptionClear(env);
-					return NULL;
-				}
+				if(string == NULL)
+					break;
+				(*env)->SetObjectArrayElement(env, stringArray, index, string);
 			}
+			(*env)->PopLocalFrame(env, NULL);
+			if (index < end)
+				break;
+		}
+		if (stringArray != NULL && index < length) {
+			(*env)->DeleteLocalRef(env, stringArray);
+			stringArray = NULL;
 		}
 	} 
 	if(stringArray == NULL) {
@@ -369,6 +692,7 @@ JavaResults * startJavaJNI( _TCHAR* libPath, _TCHAR* vmArgs[], _TCHAR* progArgs[
 	
 	if( createJavaVM(&jvm, &env, &init_args) == 0 ) {
 		registerNatives(env);
+		getStringClass(env);
 		
 		mainClassName = getMainClass(env, jarFile);
 		if (mainClassName != NULL) {
@@ -411,6 +735,11 @@ JavaResults * startJavaJNI( _TCHAR* libPath, _TCHAR* vmArgs[], _TCHAR* progArgs[
 			(*env)->ExceptionDescribe(env);
 			(*env)->ExceptionClear(env);
 		}
+#ifndef MACOSX
+		/* the vm was started on its own thread which is about to end, cleanupVM attaches the main thread */
+		if (secondThread)
+			(*jvm)->DetachCurrentThread(jvm);
+#endif
 		
 	} else {
 		results->launchResult = -4;
@@ -536,25 +865,69 @@ void cleanupVM(int exitCode) {
 	if (localEnv == 0)
 		return;
 	
+	/* with --launcher.fastExit, neither shutdown hooks nor lingering non-daemon
+	 * threads may keep us alive past the budget */
+	if (fastExitTimeout >= 0)
+		startShutdownWatchdog(exitCode);
+	
 	/* we call System.exit() unless osgi.noShutdown is set */
-	if (shouldShutdown(env)) {
+	if (shouldShutdown(localEnv)) {
 		jclass systemClass = NULL;
 		jmethodID exitMethod = NULL;
-		systemClass = (*env)->FindClass(env, "java/lang/System");
+		systemClass = (*localEnv)->FindClass(localEnv, "java/lang/System");
 		if (systemClass != NULL) {
-			exitMethod = (*env)->GetStaticMethodID(env, systemClass, "exit", "(I)V");
+			exitMethod = (*localEnv)->GetStaticMethodID(localEnv, systemClass, "exit", "(I)V");
 			if (exitMethod != NULL) {
-				(*env)->CallStaticVoidMethod(env, systemClass, exitMethod, exitCode);
+				(*localEnv)->CallStaticVoidMethod(localEnv, systemClass, exitMethod, exitCode);
 			}
 		}
-		if ((*env)->ExceptionOccurred(env)) {
-			(*env)->ExceptionDescribe(env);
-			(*env)->ExceptionClear(env);
+		if ((*localEnv)->ExceptionOccurred(localEnv)) {
+			(*localEnv)->ExceptionDescribe(localEnv);
+			(*localEnv)->ExceptionClear(localEnv);
 		}
 	}
+	releaseStringClass(localEnv);
 	(*jvm)->DestroyJavaVM(jvm);
 }
 
+static int watchdogExitCode = 0;
+
+/* Terminate the process once the shutdown budget has been used up.  The exit data
+ * has already been read by the time the VM is torn down, so only stdio is left to flush.
+ */
+#ifdef _WIN32
+static DWORD WINAPI shutdownWatchdog(LPVOID arg) {
+	Sleep(fastExitTimeout);
+#else
+static void * shutdownWatchdog(void * arg) {
+	struct timespec budget;
+	budget.tv_sec = fastExitTimeout / 1000;
+	budget.tv_nsec = (fastExitTimeout % 1000) * 1000000L;
+	while (nanosleep(&budget, &budget) != 0)
+		;
+#endif
+	fflush(stdout);
+	fflush(stderr);
+	_exit(watchdogExitCode);
+	return 0;
+}
+
+static void startShutdownWatchdog(int exitCode) {
+	watchdogExitCode = exitCode;
+#ifdef _WIN32
+	HANDLE thread = CreateThread(NULL, 0, shutdownWatchdog, NULL, 0, NULL);
+	if (thread != NULL)
+		CloseHandle(thread);
+#else
+	pthread_t thread;
+	pthread_attr_t attributes;
+	pthread_attr_init(&attributes);
+	pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+	pthread_create(&thread, &attributes, shutdownWatchdog, NULL);
+	pthread_attr_destroy(&attributes);
+#endif
+}
+
 static int shouldShutdown(JNIEnv * env) {
 	jclass booleanClass = NULL;
 	jmethodID method = NULL;
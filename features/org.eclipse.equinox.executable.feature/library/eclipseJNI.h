@@ -30,10 +30,12 @@ typedef jint (JNICALL *JNI_createJavaVM)(JavaVM **pvm, JNIEnv **env, void *args)
 #define set_exit_data 		Java_org_eclipse_equinox_launcher_JNIBridge__1set_1exit_1data
 #define set_launcher_info	Java_org_eclipse_equinox_launcher_JNIBridge__1set_1launcher_1info
 #define update_splash 		Java_org_eclipse_equinox_launcher_JNIBridge__1update_1splash
+#define update_splash_progress	Java_org_eclipse_equinox_launcher_JNIBridge__1update_1splash_1progress
 #define show_splash			Java_org_eclipse_equinox_launcher_JNIBridge__1show_1splash
 #define get_splash_handle 	Java_org_eclipse_equinox_launcher_JNIBridge__1get_1splash_1handle
 #define takedown_splash 	Java_org_eclipse_equinox_launcher_JNIBridge__1takedown_1splash
 #define get_os_recommended_folder 	    Java_org_eclipse_equinox_launcher_JNIBridge__1get_1os_1recommended_1folder
+#define get_framework_location 	Java_org_eclipse_equinox_launcher_JNIBridge__1get_1framework_1location
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +58,12 @@ JNIEXPORT void JNICALL set_launcher_info(JNIEnv *, jobject, jstring, jstring);
  */
 JNIEXPORT void JNICALL update_splash(JNIEnv *, jobject);
 
+/*
+ * org_eclipse_equinox_launcher_JNIBridge#_update_splash_progress
+ * Signature: (IILjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL update_splash_progress(JNIEnv *, jobject, jint, jint, jstring);
+
 /*
  * org_eclipse_equinox_launcher_JNIBridge#_get_splash_handle
  * Signature: ()J
@@ -80,6 +88,12 @@ JNIEXPORT void JNICALL takedown_splash(JNIEnv *, jobject);
  */
 JNIEXPORT jstring JNICALL get_os_recommended_folder(JNIEnv *, jobject);
 
+/*
+ * org_eclipse_equinox_launcher_JNIBridge#_get_framework_location
+ * Signature: ()Ljava/lang/String
+ */
+JNIEXPORT jstring JNICALL get_framework_location(JNIEnv *, jobject);
+
 #ifdef __cplusplus
 }
 #endif
@@ -94,4 +108,8 @@ JNIEXPORT jstring JNICALL get_os_recommended_folder(JNIEnv *, jobject);
 extern JavaResults* startJavaJNI( _TCHAR* libPath, _TCHAR* vmArgs[], _TCHAR* progArgs[], _TCHAR* jarFile );
 
 extern void cleanupVM( int );
+
+/* The NativeMemoryTracking summary of the VM started by startJavaJNI in KB, NULL if none.
+ * The result must be freed. */
+extern _TCHAR* getNativeMemorySummary();
 #endif
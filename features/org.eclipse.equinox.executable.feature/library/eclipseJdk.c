@@ -0,0 +1,448 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* JDK registry for --launcher.vmVersion and --launcher.vmVendor
+ *
+ * Every JDK carries a "release" properties file in its home directory with
+ * JAVA_VERSION and IMPLEMENTOR, so the registry never has to run java to
+ * find out what it is.  The scan result is cached, the cache is thrown away
+ * as soon as one of the scanned directories or release files changes.
+ *
+ * Cache file format, one record per line, fields separated by tabs:
+ *   R <mtime> <root directory>
+ *   H <$JAVA_HOME>
+ *   J <release mtime> <loadable> <JAVA_VERSION> <IMPLEMENTOR> <home>
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipseJdk.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <elf.h>
+#include <glob.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CACHE_FILE		"jdks"
+#define RELEASE_FILE	"release"
+#define MAX_LINE		(PATH_MAX + 512)
+
+typedef struct {
+	char*	home;		/* canonical JDK directory */
+	char*	version;	/* JAVA_VERSION from the release file */
+	char*	vendor;		/* IMPLEMENTOR from the release file, may be empty */
+	long	mtime;		/* modification time of the release file */
+	int		loadable;	/* libjvm was built for the same architecture as this launcher */
+} Jdk;
+
+typedef struct {
+	Jdk*	jdks;
+	int		count;
+	int		size;
+} JdkList;
+
+static const char* systemRoots[] = { "/usr/lib/jvm", "/usr/lib64/jvm", NULL };
+static const char* userRoots[] = { ".sdkman/candidates/java", ".gradle/jdks", ".jdks", NULL };
+static const char* libjvmPatterns[] = { "%s/lib/*/libjvm.so", "%s/lib/*/*/libjvm.so", "%s/jre/lib/*/*/libjvm.so", NULL };
+
+static long modificationTime(const char* path) {
+	struct stat stats;
+	if (stat(path, &stats) != 0)
+		return -1;
+	return (long) stats.st_mtime;
+}
+
+static char* childPath(const char* dir, const char* name) {
+	char* result = malloc(strlen(dir) + 1 + strlen(name) + 1);
+	sprintf(result, "%s/%s", dir, name);
+	return result;
+}
+
+/* Roots that contain JDK directories: the system ones, then the ones in the user's home */
+static char** getRoots() {
+	char* home = getenv("HOME");
+	int systemCount = sizeof(systemRoots) / sizeof(systemRoots[0]) - 1;
+	int userCount = sizeof(userRoots) / sizeof(userRoots[0]) - 1;
+	char** roots = malloc((systemCount + userCount + 1) * sizeof(char*));
+	int i, dst = 0;
+
+	for (i = 0; systemRoots[i] != NULL; i++)
+		roots[dst++] = strdup(systemRoots[i]);
+	if (home != NULL && home[0] != 0) {
+		for (i = 0; userRoots[i] != NULL; i++)
+			roots[dst++] = childPath(home, userRoots[i]);
+	}
+	roots[dst] = NULL;
+	return roots;
+}
+
+static void freeList(char** list) {
+	int i;
+	for (i = 0; list[i] != NULL; i++)
+		free(list[i]);
+	free(list);
+}
+
+static void freeJdks(JdkList* list) {
+	int i;
+	for (i = 0; i < list->count; i++) {
+		free(list->jdks[i].home);
+		free(list->jdks[i].version);
+		free(list->jdks[i].vendor);
+	}
+	free(list->jdks);
+	list->jdks = NULL;
+	list->count = list->size = 0;
+}
+
+static Jdk* appendJdk(JdkList* list) {
+	if (list->count == list->size) {
+		list->size = (list->size == 0) ? 8 : list->size * 2;
+		list->jdks = realloc(list->jdks, list->size * sizeof(Jdk));
+	}
+	memset(&list->jdks[list->count], 0, sizeof(Jdk));
+	return &list->jdks[list->count++];
+}
+
+/* Return the value of a KEY="value" line if it is for the given key */
+static char* releaseValue(char* line, const char* key) {
+	size_t length = strlen(key);
+	char* value;
+	char* end;
+
+	if (strncmp(line, key, length) != 0 || line[length] != '=')
+		return NULL;
+	value = line + length + 1;
+	end = value + strlen(value);
+	while (end > value && isspace((unsigned char) end[-1]))
+		*--end = 0;
+	if (*value == '"') {
+		value++;
+		if (end > value && end[-1] == '"')
+			end[-1] = 0;
+	}
+	return value;
+}
+
+static int readRelease(const char* home, Jdk* jdk) {
+	char line[MAX_LINE];
+	char* path = childPath(home, RELEASE_FILE);
+	FILE* file = fopen(path, "r");
+	char* value;
+
+	jdk->mtime = modificationTime(path);
+	free(path);
+	if (file == NULL)
+		return -1;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (jdk->version == NULL && (value = releaseValue(line, "JAVA_VERSION")) != NULL)
+			jdk->version = strdup(value);
+		else if (jdk->vendor == NULL && (value = releaseValue(line, "IMPLEMENTOR")) != NULL)
+			jdk->vendor = strdup(value);
+	}
+	fclose(file);
+	if (jdk->vendor == NULL)
+		jdk->vendor = strdup("");
+	return (jdk->version != NULL) ? 0 : -1;
+}
+
+/* Read the part of the ELF header that tells class, byte order and machine */
+static int readElfHeader(const char* path, unsigned char header[20]) {
+	FILE* file = fopen(path, "rb");
+	int ok;
+	if (file == NULL)
+		return -1;
+	ok = (fread(header, 1, 20, file) == 20) && memcmp(header, ELFMAG, SELFMAG) == 0;
+	fclose(file);
+	return ok ? 0 : -1;
+}
+
+/* A libjvm is loadable if it was built for the same architecture as we were */
+static int isLoadable(const char* home) {
+	unsigned char self[20], lib[20];
+	char pattern[PATH_MAX + 32];
+	int i, result = 0;
+	size_t j;
+
+	if (readElfHeader("/proc/self/exe", self) != 0)
+		return 0;
+	for (i = 0; libjvmPatterns[i] != NULL && !result; i++) {
+		glob_t matches;
+		snprintf(pattern, sizeof(pattern), libjvmPatterns[i], home);
+		if (glob(pattern, 0, NULL, &matches) != 0)
+			continue;
+		for (j = 0; j < matches.gl_pathc && !result; j++) {
+			if (readElfHeader(matches.gl_pathv[j], lib) == 0 &&
+				lib[EI_CLASS] == self[EI_CLASS] && lib[EI_DATA] == self[EI_DATA] &&
+				lib[18] == self[18] && lib[19] == self[19])	/* e_machine */
+				result = 1;
+		}
+		globfree(&matches);
+	}
+	return result;
+}
+
+/* Add the JDK in dir, returns 0 if dir is a JDK home */
+static int addJdk(JdkList* list, const char* dir) {
+	char home[PATH_MAX];
+	Jdk* jdk;
+	int i;
+
+	if (realpath(dir, home) == NULL)
+		return -1;
+	/* /usr/lib/jvm is full of symlinks to the same JDK */
+	for (i = 0; i < list->count; i++) {
+		if (strcmp(list->jdks[i].home, home) == 0)
+			return 0;
+	}
+	jdk = appendJdk(list);
+	if (readRelease(home, jdk) != 0) {
+		free(jdk->version);
+		free(jdk->vendor);
+		list->count--;
+		return -1;
+	}
+	jdk->home = strdup(home);
+	jdk->loadable = isLoadable(home);
+	return 0;
+}
+
+/* JDKs are either direct children of a root or, for Gradle toolchains, one level further down */
+static void scanRoot(JdkList* list, const char* root, int depth) {
+	DIR* dir = opendir(root);
+	struct dirent* entry;
+
+	if (dir == NULL)
+		return;
+	while ((entry = readdir(dir)) != NULL) {
+		char* path;
+		if (entry->d_name[0] == '.')
+			continue;
+		path = childPath(root, entry->d_name);
+		if (addJdk(list, path) != 0 && depth > 0)
+			scanRoot(list, path, depth - 1);
+		free(path);
+	}
+	closedir(dir);
+}
+
+static int splitLine(char* line, char* fields[], int count) {
+	int n = 0;
+	fields[n++] = line;
+	while (n < count && (line = strchr(line, '\t')) != NULL) {
+		*line++ = 0;
+		fields[n++] = line;
+	}
+	return n;
+}
+
+/* Load the cache, returns 0 if it still describes the given roots */
+static int readCache(const char* cacheFile, JdkList* list, char** roots, const char* javaHome) {
+	char line[MAX_LINE];
+	char* fields[6];
+	FILE* file = fopen(cacheFile, "r");
+	int root = 0, valid = 1, sawHome = 0;
+
+	if (file == NULL)
+		return -1;
+	while (valid && fgets(line, sizeof(line), file) != NULL) {
+		line[strcspn(line, "\n")] = 0;
+		if (line[0] == 'R' && splitLine(line, fields, 3) == 3) {
+			valid = roots[root] != NULL && strcmp(fields[2], roots[root]) == 0 &&
+					atol(fields[1]) == modificationTime(roots[root]);
+			root++;
+		} else if (line[0] == 'H' && splitLine(line, fields, 2) == 2) {
+			valid = strcmp(fields[1], javaHome) == 0;
+			sawHome = 1;
+		} else if (line[0] == 'J' && splitLine(line, fields, 6) == 6) {
+			Jdk* jdk = appendJdk(list);
+			jdk->mtime = atol(fields[1]);
+			jdk->loadable = atoi(fields[2]);
+			jdk->version = strdup(fields[3]);
+			jdk->vendor = strdup(fields[4]);
+			jdk->home = strdup(fields[5]);
+			{
+				char* release = childPath(jdk->home, RELEASE_FILE);
+				valid = (modificationTime(release) == jdk->mtime);
+				free(release);
+			}
+		} else if (line[0] != '#') {
+			valid = 0;
+		}
+	}
+	fclose(file);
+	if (!valid || roots[root] != NULL || !sawHome) {
+		freeJdks(list);
+		return -1;
+	}
+	return 0;
+}
+
+static void writeCache(const char* cacheFile, JdkList* list, char** roots, const char* javaHome) {
+	char* tmpFile = malloc(strlen(cacheFile) + 16);
+	FILE* file;
+	int i;
+
+	sprintf(tmpFile, "%s.%d", cacheFile, (int) getpid());
+	file = fopen(tmpFile, "w");
+	if (file == NULL) {
+		free(tmpFile);
+		return;
+	}
+	fprintf(file, "# JDKs found by the eclipse launcher\n");
+	for (i = 0; roots[i] != NULL; i++)
+		fprintf(file, "R\t%ld\t%s\n", modificationTime(roots[i]), roots[i]);
+	fprintf(file, "H\t%s\n", javaHome);
+	for (i = 0; i < list->count; i++) {
+		Jdk* jdk = &list->jdks[i];
+		fprintf(file, "J\t%ld\t%d\t%s\t%s\t%s\n", jdk->mtime, jdk->loadable, jdk->version, jdk->vendor, jdk->home);
+	}
+	if (fclose(file) == 0)
+		rename(tmpFile, cacheFile);
+	else
+		unlink(tmpFile);
+	free(tmpFile);
+}
+
+/* Parse a java version into major.minor.micro, 1.8.0_352 becomes 8.0.352 */
+static void parseVersion(const char* str, int version[3]) {
+	version[0] = version[1] = version[2] = 0;
+	sscanf(str, "%d.%d.%d", &version[0], &version[1], &version[2]);
+	if (version[0] == 1) {
+		/* only look for the update number within this version, str may be a range */
+		size_t length = strcspn(str, ",)] \t");
+		const char* update = memchr(str, '_', length);
+		version[0] = version[1];
+		version[1] = version[2];
+		version[2] = (update != NULL) ? atoi(update + 1) : 0;
+	}
+}
+
+static int compareVersion(const int a[3], const int b[3]) {
+	int i;
+	for (i = 0; i < 3; i++) {
+		if (a[i] != b[i])
+			return (a[i] < b[i]) ? -1 : 1;
+	}
+	return 0;
+}
+
+/* OSGi version range: "[low,high)", "(low,high]", ... or just "low" meaning low and above */
+static int inRange(const char* range, const int version[3]) {
+	int bound[3];
+	const char* high;
+	int cmp;
+
+	if (range == NULL)
+		return 1;
+	while (isspace((unsigned char) *range))
+		range++;
+	if (*range == 0)
+		return 1;
+	if (*range != '[' && *range != '(') {
+		parseVersion(range, bound);
+		return compareVersion(version, bound) >= 0;
+	}
+
+	parseVersion(range + 1, bound);
+	cmp = compareVersion(version, bound);
+	if (cmp < 0 || (cmp == 0 && *range == '('))
+		return 0;
+
+	high = strchr(range, ',');
+	if (high == NULL)
+		return 1;
+	high++;
+	while (isspace((unsigned char) *high))
+		high++;
+	if (!isdigit((unsigned char) *high))
+		return 1;	/* "[17,)" has no upper bound */
+	parseVersion(high, bound);
+	cmp = compareVersion(version, bound);
+	if (cmp > 0 || (cmp == 0 && strchr(high, ']') == NULL))
+		return 0;
+	return 1;
+}
+
+static int containsIgnoreCase(const char* str, const char* part) {
+	size_t length = strlen(part);
+	for (; *str != 0; str++) {
+		if (strncasecmp(str, part, length) == 0)
+			return 1;
+	}
+	return length == 0;
+}
+
+char* findRegisteredJava(char* versionRange, char* vendor) {
+	JdkList list = { NULL, 0, 0 };
+	char** roots = getRoots();
+	char* javaHome = getenv("JAVA_HOME");
+	char* cacheDir = getLauncherCacheDir();
+	char* cacheFile = (cacheDir != NULL) ? childPath(cacheDir, CACHE_FILE) : NULL;
+	char* result = NULL;
+	int bestVersion[3];
+	int bestMatch = -1;
+	int i;
+
+	if (javaHome == NULL)
+		javaHome = "";
+
+	if (cacheFile == NULL || readCache(cacheFile, &list, roots, javaHome) != 0) {
+		if (javaHome[0] != 0)
+			addJdk(&list, javaHome);
+		for (i = 0; roots[i] != NULL; i++)
+			scanRoot(&list, roots[i], 1);
+		if (cacheFile != NULL)
+			writeCache(cacheFile, &list, roots, javaHome);
+	}
+
+	for (i = 0; i < list.count; i++) {
+		Jdk* jdk = &list.jdks[i];
+		int version[3];
+		int match;
+		char* java;
+
+		if (!jdk->loadable)
+			continue;
+		parseVersion(jdk->version, version);
+		if (!inRange(versionRange, version))
+			continue;
+		match = (vendor != NULL) ? containsIgnoreCase(jdk->vendor, vendor) : 0;
+		if (match < bestMatch || (match == bestMatch && compareVersion(version, bestVersion) <= 0))
+			continue;
+
+		java = childPath(jdk->home, "bin/java");
+		if (access(java, X_OK) != 0) {
+			free(java);
+			continue;
+		}
+		free(result);
+		result = java;
+		bestMatch = match;
+		memcpy(bestVersion, version, sizeof(bestVersion));
+	}
+
+	freeJdks(&list);
+	freeList(roots);
+	free(cacheFile);
+	free(cacheDir);
+	return result;
+}
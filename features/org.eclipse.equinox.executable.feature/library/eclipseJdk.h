@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_JDK_H
+#define ECLIPSE_JDK_H
+
+/* Registry of the JDKs installed on this host, Linux only */
+
+/**
+ * Find the java executable of the newest installed JDK whose version
+ * lies in the given OSGi version range (e.g. "[17,22)", or "17" for
+ * 17 and later) and whose libjvm can be loaded by this launcher.
+ * JDKs whose IMPLEMENTOR contains vendor (case insensitive) are
+ * preferred over newer JDKs from other vendors.  Either argument
+ * may be NULL.
+ *
+ * JDKs are looked for in /usr/lib/jvm, /usr/lib64/jvm, $JAVA_HOME,
+ * SDKMAN (~/.sdkman/candidates/java), Gradle toolchains (~/.gradle/jdks)
+ * and ~/.jdks.  Their release files are cached in
+ * $XDG_CACHE_HOME/eclipse/jdks until one of those locations changes.
+ *
+ * Returns NULL if no JDK matches.  The result must be freed with free().
+ */
+extern char* findRegisteredJava(char* versionRange, char* vendor);
+
+#endif /* ECLIPSE_JDK_H */
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_LAUNCH_H
+#define ECLIPSE_LAUNCH_H
+
+#include "eclipseUnicode.h"
+
+/* Embedding API of the eclipse shared library
+ *
+ * Lets a process that loaded the eclipse library prepare, start and supervise
+ * several Java VMs of one installation side by side.  The VMs are always
+ * exec'd, the library does not show a splash screen for them and does not
+ * handle the restart exit codes; that is up to the caller.  Their output goes
+ * to the caller's stdout and stderr, --launcher.logTo does not apply.
+ *
+ * A LaunchContext may only be used by one thread at a time, different
+ * contexts may be used concurrently.  All contexts of a process belong to the
+ * installation of the first one prepared.
+ *
+ * Available on the platforms built with eclipseNix.c, not on Windows or
+ * Mac OS X.  The headless launcher contains it as well, but links it in
+ * statically.  See gtk/eclipseMultiLaunch.c for an example.
+ */
+
+typedef struct LaunchContext LaunchContext;
+
+/**
+ * Prepare a launch from a launcher command line: argv[0] is the eclipse
+ * executable of the installation, the remaining arguments are parsed like
+ * the launcher's (only the options choosing the VM and the startup jar are
+ * honoured, the others are removed).  vmArgs may be NULL, the -vmargs of
+ * the launcher.ini files are merged in as the launcher would.
+ * The arguments must stay valid until the context is freed.
+ */
+extern LaunchContext* prepareLaunch(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]);
+
+/**
+ * Find the Java VM and the startup jar and build the command line.
+ * Returns 0 if success, otherwise msg is set to a description of the
+ * problem, to be freed by the caller.
+ */
+extern int resolveLaunch(LaunchContext* context, _TCHAR** msg);
+
+/**
+ * Returns the resolved command line, NULL terminated, or NULL if the
+ * launch was not resolved yet.  The list belongs to the context.
+ */
+extern _TCHAR** getLaunchCommand(LaunchContext* context);
+
+/**
+ * Start the resolved Java VM.  Returns its process id, or -1 if it
+ * could not be started.
+ */
+extern int launchJavaExe(LaunchContext* context);
+
+/**
+ * Wait for the Java VM started by launchJavaExe to terminate and return
+ * its exit code.  If exitData is not NULL, it is set to the exit data the
+ * VM left behind (NULL if none), to be freed by the caller.
+ */
+extern int waitForLaunch(LaunchContext* context, _TCHAR** exitData);
+
+/**
+ * Free the context and everything allocated for it.
+ */
+extern void freeLaunch(LaunchContext* context);
+
+#endif /* ECLIPSE_LAUNCH_H */
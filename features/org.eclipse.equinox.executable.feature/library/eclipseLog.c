@@ -0,0 +1,360 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Output relay for --launcher.logTo
+ *
+ * An exec'd VM normally writes to the launcher's stdout and stderr.  When
+ * those are a slow terminal, an ssh session or a pipe nobody reads, every
+ * log statement of the framework waits for them.  With --launcher.logTo the
+ * VM writes into a pipe instead, which the launcher empties into the log
+ * file with splice() while it waits for the VM (see launchJavaVM).  The
+ * terminal gets a copy through tee() as long as it keeps up, what it can't
+ * take is only missing there.  stdout and stderr have a pipe each, so that
+ * the copies go to the launcher's stdout and stderr respectively.
+ */
+
+#define _GNU_SOURCE
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipseLog.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RELAY_CHUNK		(64 * 1024)
+#define RELAY_PIPE_SIZE	(1024 * 1024)	/* absorbs bursts while the launcher is busy */
+#define ECHO_CHUNK		4096			/* small enough not to block on a terminal that polled writable */
+#define LOG_BACKUPS		3
+#define STOP_TIMEOUT	100				/* ms the terminal gets to take the rest of the copy */
+
+/* stdout or stderr of the VM, both go to the log file and each to its own terminal */
+typedef struct {
+	int relay[2];		/* VM -> launcher */
+	int echo[2];		/* copy for the terminal */
+	int echoPending;
+	int terminal;		/* the launcher's stdout or stderr */
+	int lineStart;
+} Stream;
+
+static Stream streams[2] = {
+	{ { -1, -1 }, { -1, -1 }, 0, STDOUT_FILENO, 1 },
+	{ { -1, -1 }, { -1, -1 }, 0, STDERR_FILENO, 1 }
+};
+static int   logFd = -1;
+static char* logPath = NULL;
+static long  logSize = 0;
+static long  logMaxSize = 0;
+static int   logTimestamps = 0;
+
+static int openLog() {
+	struct stat stats;
+	logFd = open(logPath, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+	if (logFd < 0)
+		return -1;
+	/* no O_APPEND, splice() refuses to write to such files */
+	logSize = (fstat(logFd, &stats) == 0) ? stats.st_size : 0;
+	lseek(logFd, 0, SEEK_END);
+	return 0;
+}
+
+/* logFile -> logFile.1 -> ... -> logFile.<LOG_BACKUPS> */
+static void rotateLog() {
+	char* from = malloc(strlen(logPath) + 16);
+	char* to = malloc(strlen(logPath) + 16);
+	int i;
+
+	close(logFd);
+	for (i = LOG_BACKUPS - 1; i > 0; i--) {
+		sprintf(from, "%s.%d", logPath, i);
+		sprintf(to, "%s.%d", logPath, i + 1);
+		rename(from, to);
+	}
+	sprintf(to, "%s.1", logPath);
+	rename(logPath, to);
+	free(from);
+	free(to);
+
+	openLog();
+}
+
+static void writeAll(int fd, const char* buffer, size_t length) {
+	while (length > 0) {
+		ssize_t written = write(fd, buffer, length);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+		buffer += written;
+		length -= written;
+	}
+}
+
+/* read() and write() for what splice() can't do: timestamps, and files that don't support it */
+static ssize_t copyOutput(Stream* stream, size_t length) {
+	char buffer[RELAY_CHUNK];
+	char stamp[32];
+	ssize_t count, start = 0, i;
+	struct timespec now;
+	struct tm local;
+
+	count = read(stream->relay[0], buffer, length < sizeof(buffer) ? length : sizeof(buffer));
+	if (count <= 0 || !logTimestamps) {
+		if (count > 0)
+			writeAll(logFd, buffer, count);
+		return count;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime_r(&now.tv_sec, &local));
+	sprintf(stamp + strlen(stamp), ".%03d ", (int) (now.tv_nsec / 1000000));
+	for (i = 0; i < count; i++) {
+		if (stream->lineStart) {
+			writeAll(logFd, stamp, strlen(stamp));
+			logSize += strlen(stamp);
+			stream->lineStart = 0;
+		}
+		if (buffer[i] == '\n') {
+			writeAll(logFd, buffer + start, i + 1 - start);
+			start = i + 1;
+			stream->lineStart = 1;
+		}
+	}
+	writeAll(logFd, buffer + start, count - start);
+	return count;
+}
+
+/* Move what is in the relay pipe to the log file, returns 0 at the end of the output
+ * and -1 with EAGAIN if there is nothing to move right now
+ */
+static ssize_t moveOutput(Stream* stream) {
+	size_t length = RELAY_CHUNK;
+	ssize_t moved = -1;
+
+	/* the terminal gets exactly what the file gets next, or nothing if its copy is full */
+	if (stream->echo[1] >= 0) {
+		ssize_t copied = tee(stream->relay[0], stream->echo[1], RELAY_CHUNK, SPLICE_F_NONBLOCK);
+		if (copied > 0) {
+			length = copied;
+			stream->echoPending = 1;
+		}
+	}
+
+	if (!logTimestamps) {
+		moved = splice(stream->relay[0], NULL, logFd, NULL, length, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if (moved < 0 && errno == EINVAL)
+			moved = copyOutput(stream, length);
+	} else {
+		moved = copyOutput(stream, length);
+	}
+
+	if (moved > 0) {
+		logSize += moved;
+		if (logMaxSize > 0 && logSize >= logMaxSize)
+			rotateLog();
+	}
+	return moved;
+}
+
+/* Pass the copy on to the terminal as long as it is writable, it polled so once */
+static void echoOutput(Stream* stream) {
+	char buffer[ECHO_CHUNK];
+	struct pollfd terminal;
+	ssize_t count;
+	int total = 0;
+
+	terminal.fd = stream->terminal;
+	terminal.events = POLLOUT;
+	do {
+		count = splice(stream->echo[0], NULL, stream->terminal, NULL, ECHO_CHUNK, SPLICE_F_NONBLOCK);
+		if (count < 0 && errno == EINVAL) {
+			/* terminals don't splice */
+			count = read(stream->echo[0], buffer, sizeof(buffer));
+			if (count > 0)
+				writeAll(stream->terminal, buffer, count);
+		}
+		if (count <= 0) {
+			stream->echoPending = 0;
+			return;
+		}
+		total += count;
+	} while (total < RELAY_CHUNK && poll(&terminal, 1, 0) > 0);
+}
+
+static void closeStream(Stream* stream) {
+	if (stream->relay[0] >= 0) {
+		close(stream->relay[0]);
+		stream->relay[0] = -1;
+	}
+}
+
+static int openStream(Stream* stream) {
+	if (pipe2(stream->relay, O_CLOEXEC) != 0) {
+		stream->relay[0] = stream->relay[1] = -1;
+		return -1;
+	}
+	/* the launcher reads without waiting: children of the VM may keep the write end open */
+	fcntl(stream->relay[0], F_SETFL, fcntl(stream->relay[0], F_GETFL) | O_NONBLOCK);
+	fcntl(stream->relay[1], F_SETPIPE_SZ, RELAY_PIPE_SIZE);
+	stream->lineStart = 1;
+
+	/* no copy if the launcher has no such terminal */
+	if (fcntl(stream->terminal, F_GETFL) == -1 || pipe2(stream->echo, O_CLOEXEC | O_NONBLOCK) != 0) {
+		stream->echo[0] = stream->echo[1] = -1;
+	} else {
+		fcntl(stream->echo[1], F_SETPIPE_SZ, RELAY_PIPE_SIZE);
+	}
+	return 0;
+}
+
+int startLogRelay(char* logFile, long maxSize, int timestamps) {
+	if (streams[0].relay[0] >= 0 || openStream(&streams[0]) != 0)
+		return -1;
+	if (openStream(&streams[1]) != 0) {
+		stopLogRelay();
+		return -1;
+	}
+	logPath = strdup(logFile);
+	logMaxSize = maxSize;
+	logTimestamps = timestamps;
+	if (openLog() != 0) {
+		stopLogRelay();
+		return -1;
+	}
+	return 0;
+}
+
+void redirectToLogRelay() {
+	if (streams[0].relay[1] >= 0) {
+		dup2(streams[0].relay[1], STDOUT_FILENO);
+		dup2(streams[1].relay[1], STDERR_FILENO);
+	}
+}
+
+void closeLogRelayInput() {
+	int i;
+	for (i = 0; i < 2; i++) {
+		if (streams[i].relay[1] >= 0) {
+			close(streams[i].relay[1]);
+			streams[i].relay[1] = -1;
+		}
+	}
+}
+
+int relayLog(int process, int timeout, int wakeFd) {
+	struct pollfd fds[5];
+	Stream* polled[5];
+	int echoing[5];
+	siginfo_t info;
+	int count = 0, open = 0, i;
+
+	if (streams[0].relay[1] >= 0)
+		return 0;	/* no VM writing to the relay */
+	for (i = 0; i < 2; i++) {
+		Stream* stream = &streams[i];
+		if (stream->relay[0] >= 0) {
+			fds[count].fd = stream->relay[0];
+			fds[count].events = POLLIN;
+			fds[count].revents = 0;
+			echoing[count] = 0;
+			polled[count++] = stream;
+			open = 1;
+		}
+		if (stream->echoPending) {
+			fds[count].fd = stream->terminal;
+			fds[count].events = POLLOUT;
+			fds[count].revents = 0;
+			echoing[count] = 1;
+			polled[count++] = stream;
+		}
+	}
+	if (!open)
+		return 0;	/* no relay, or the VM closed its output */
+	if (wakeFd >= 0) {
+		fds[count].fd = wakeFd;
+		fds[count].events = POLLIN;
+		fds[count].revents = 0;
+		echoing[count] = 0;
+		polled[count++] = NULL;
+	}
+	if (poll(fds, count, timeout) < 0)
+		return errno == EINTR;
+
+	for (i = 0; i < count; i++) {
+		Stream* stream = polled[i];
+		if (stream == NULL)
+			continue;	/* wakeFd, read by the caller */
+		if (echoing[i]) {
+			if (fds[i].revents & POLLOUT)
+				echoOutput(stream);
+		} else if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+			ssize_t moved = moveOutput(stream);
+			if (moved == 0 || (moved < 0 && errno != EAGAIN && errno != EINTR))
+				closeStream(stream);
+		}
+	}
+	if (streams[0].relay[0] < 0 && streams[1].relay[0] < 0)
+		return 0;
+
+	/* children of the VM may keep the output open after it terminated */
+	info.si_pid = 0;
+	if (waitid(P_PID, (id_t) process, &info, WEXITED | WNOHANG | WNOWAIT) == 0 && info.si_pid != 0)
+		return 0;
+	return 1;
+}
+
+void stopLogRelay() {
+	struct pollfd terminal;
+	int i;
+
+	closeLogRelayInput();
+	for (i = 0; i < 2; i++) {
+		Stream* stream = &streams[i];
+
+		/* whatever is left if the launcher stopped waiting before the end of the output */
+		if (stream->relay[0] >= 0 && logFd >= 0) {
+			while (moveOutput(stream) > 0)
+				;
+		}
+		closeStream(stream);
+
+		terminal.fd = stream->terminal;
+		terminal.events = POLLOUT;
+		while (stream->echoPending && poll(&terminal, 1, STOP_TIMEOUT) > 0)
+			echoOutput(stream);
+		stream->echoPending = 0;
+		if (stream->echo[0] >= 0) {
+			close(stream->echo[0]);
+			close(stream->echo[1]);
+			stream->echo[0] = stream->echo[1] = -1;
+		}
+	}
+
+	if (logFd >= 0) {
+		close(logFd);
+		logFd = -1;
+	}
+	free(logPath);
+	logPath = NULL;
+}
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_LOG_H
+#define ECLIPSE_LOG_H
+
+/* Relay of the output of an exec'd VM for --launcher.logTo, Linux only */
+
+/**
+ * Relay stdout and stderr of the next VM started with startJavaProcess()
+ * to logFile, and each to the launcher's own as far as that keeps up.  The
+ * file is moved to logFile.1 (logFile.2, ...) when it grows beyond maxSize
+ * bytes, 0 for no limit.  If timestamps is set, every line is prefixed
+ * with the time it was relayed.
+ * Returns 0 if success.
+ */
+extern int startLogRelay(char* logFile, long maxSize, int timestamps);
+
+/**
+ * In the forked VM process: make the relay its stdout and stderr.
+ */
+extern void redirectToLogRelay();
+
+/**
+ * In the launcher once the VM is forked: close the VM's end of the relay.
+ */
+extern void closeLogRelayInput();
+
+/**
+ * Relay what the VM wrote, waiting up to timeout milliseconds for it
+ * (-1 waits until there is something) or for wakeFd to be readable, -1
+ * for none.  Returns 0 without waiting once the VM closed its output or
+ * the process has terminated (it is left to be waited for), or if there
+ * is no relay, 1 otherwise.
+ */
+extern int relayLog(int process, int timeout, int wakeFd);
+
+/**
+ * Relay what is left, then close the log file.
+ */
+extern void stopLogRelay();
+
+#endif /* ECLIPSE_LOG_H */
@@ -33,6 +33,11 @@
 
 #include "eclipse-memcpy.h"
 
+#ifdef LINUX
+#include "eclipseStamp.h"
+#endif
+
+#ifndef HEADLESS
 static _TCHAR* libraryMsg =
 _T_ECLIPSE("The %s executable launcher was unable to locate its \n\
 companion shared library.");
@@ -40,6 +45,7 @@ companion shared library.");
 static _TCHAR* entryMsg =
 _T_ECLIPSE("There was a problem loading the shared library and \n\
 finding the entry point.");
+#endif
 
 static _TCHAR* rootMsg =
 _T_ECLIPSE("The %s executable launcher is configured to not start with \n\
@@ -57,6 +63,7 @@ administrative privileges.");
 /* this typedef must match the run method in eclipse.c */
 typedef int (*RunMethod)(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]);
 typedef void (*SetInitialArgs)(int argc, _TCHAR*argv[], _TCHAR* library);
+typedef void (*SetEmbeddedIni)(_TCHAR* ini);
 
 static _TCHAR*  name          = NULL;			/* program name */
 static _TCHAR** userVMarg     = NULL;     		/* user specific args for the Java VM */
@@ -69,7 +76,9 @@ static int 	 	createUserArgs(int configArgc, _TCHAR **configArgv, int *argc, _TC
 static void  	parseArgs( int* argc, _TCHAR* argv[], int handleVMArgs );
 static _TCHAR* 	getDefaultOfficialName(_TCHAR* program);
 static _TCHAR*  findProgram(_TCHAR* argv[]);
+#ifndef HEADLESS
 static _TCHAR*  findLibrary(_TCHAR* library, _TCHAR* program);
+#endif
 static _TCHAR*  checkForIni(int argc, _TCHAR* argv[]);
 static _TCHAR*  getDirFromProgram(_TCHAR* program);
 static int  isRoot();
@@ -77,7 +86,24 @@ static int  isRoot();
 static int initialArgc;
 static _TCHAR** initialArgv;
 
+#ifdef LINUX
+/* the launcher.ini, if eclipse-stamp wrote one into the executable */
+__attribute__((section(EMBEDDED_INI_SECTION), used))
+char embeddedIni[EMBEDDED_INI_SIZE] = EMBEDDED_INI_MAGIC;
+
+static _TCHAR* getEmbeddedIni() {
+	return embeddedIni[EMBEDDED_INI_OFFSET] != 0 ? embeddedIni + EMBEDDED_INI_OFFSET : NULL;
+}
+#endif
+
+#ifdef HEADLESS
+/* the launcher library is linked in (see make_linux.mak) */
+extern void setInitialArgs(int argc, _TCHAR* argv[], _TCHAR* library);
+extern void setEmbeddedIni(_TCHAR* ini);
+extern int run(int argc, _TCHAR* argv[], _TCHAR* vmArgs[]);
+#else
 _TCHAR* eclipseLibrary = NULL; /* path to the eclipse shared library */
+#endif
 
 #ifdef UNICODE
 extern int main(int, char**);
@@ -122,9 +148,14 @@ int main( int argc, _TCHAR* argv[] )
 	int 	 configArgc = 0;
 	int      exitCode = 0;
 	int      ret = 0;
+#ifndef HEADLESS
 	void *	 handle = 0;
 	RunMethod 		runMethod;
 	SetInitialArgs  setArgs;
+#ifdef LINUX
+	SetEmbeddedIni  setIni;
+#endif
+#endif
 	
 	setlocale(LC_ALL, "");
 	
@@ -151,6 +182,10 @@ int main( int argc, _TCHAR* argv[] )
     iniFile = checkForIni(argc, argv);
     if (iniFile != NULL)
 		ret = readConfigFile(iniFile, &configArgc, &configArgv);
+#ifdef LINUX
+    else if (getEmbeddedIni() != NULL)
+		ret = readConfigData(getEmbeddedIni(), &configArgc, &configArgv);
+#endif
     else
 		ret = readIniFile(program, &configArgc, &configArgv);
 	if (ret == 0)
@@ -176,8 +211,10 @@ int main( int argc, _TCHAR* argv[] )
 	/* Find the directory where the Eclipse program is installed. */
     programDir = getDirFromProgram(program);
 
+#ifndef HEADLESS
 	/* Find the eclipse library */
     eclipseLibrary = findLibrary(eclipseLibrary, program);
+#endif
 
     /* root check */
 	if(protectRoot && isRoot()){
@@ -191,6 +228,11 @@ int main( int argc, _TCHAR* argv[] )
         exit( 2 );
 	}
 		
+#ifdef HEADLESS
+	setInitialArgs(initialArgc, initialArgv, NULL);
+	setEmbeddedIni(getEmbeddedIni());
+	exitCode = run(argc, argv, userVMarg);
+#else
 	if(eclipseLibrary != NULL)
 		handle = loadLibrary(eclipseLibrary);
 	if(handle == NULL) {
@@ -215,6 +257,13 @@ int main( int argc, _TCHAR* argv[] )
 		exit(1);
 	}
 	
+#ifdef LINUX
+	/* optional, older libraries only know the ini file */
+	setIni = (SetEmbeddedIni)findSymbol(handle, SET_EMBEDDED_INI);
+	if (setIni != NULL)
+		setIni(getEmbeddedIni());
+#endif
+
 	runMethod = (RunMethod)findSymbol(handle, RUN_METHOD);
 	if(runMethod != NULL)
 		exitCode = runMethod(argc, argv, userVMarg);
@@ -228,6 +277,7 @@ int main( int argc, _TCHAR* argv[] )
 	unloadLibrary(handle);
 	
 	free( eclipseLibrary );
+#endif
     free( programDir );
     free( program );
     free( officialName );
@@ -235,9 +285,11 @@ int main( int argc, _TCHAR* argv[] )
 	return exitCode;
 }
 
+#ifndef HEADLESS
 _TCHAR* getProgramPath() {
 	return NULL;
 }
+#endif
 
 static _TCHAR* findProgram(_TCHAR* argv[]) {
 	_TCHAR * program;
@@ -375,6 +427,8 @@ _TCHAR* getDirFromProgram(_TCHAR* program)
 	return programDir;
 }
 
+#ifndef HEADLESS
+/* when linked with eclipse.c, its versions are used */
 _TCHAR* getProgramDir()
 {
 	return programDir;
@@ -383,6 +437,7 @@ _TCHAR* getProgramDir()
 _TCHAR* getOfficialName() {
 	return officialName;
 }
+#endif
 
 /*
  * Determine the default official application name
@@ -430,6 +485,7 @@ static _TCHAR* getDefaultOfficialName(_TCHAR* program)
 	return ch;
 }
 
+#ifndef HEADLESS
 static _TCHAR* findLibrary(_TCHAR* library, _TCHAR* program) 
 {
 	_TCHAR* c;
@@ -499,6 +555,7 @@ static _TCHAR* findLibrary(_TCHAR* library, _TCHAR* program)
 	
 	return result; 
 }
+#endif
 
 static int isRoot(){
 #ifdef LINUX
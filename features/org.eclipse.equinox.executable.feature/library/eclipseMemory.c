@@ -0,0 +1,302 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Memory footprint report for --launcher.memReport
+ *
+ * The launcher takes a snapshot of the memory of the VM process when Java
+ * takes down the splash and when it exits, and writes them as JSON:
+ *
+ *   {"launcher": <pid>, "snapshots": [
+ *     {"event": "startup", "process": <pid>, "time": <ms since the epoch>,
+ *      "peakRss": <kB>, "rollup": {<smaps_rollup fields in kB>},
+ *      "groups": {"libjvm": {"size", "rss", "pss", "private", "swap"}, ...},
+ *      "nmt": {"Total": {"reserved", "committed"}, "Java Heap": {...}, ...}}, ...]}
+ *
+ * The groups add up the mappings of /proc/<pid>/smaps: libjvm, the GTK and
+ * GDK libraries with GLib, the CDS archive, the code cache (the anonymous
+ * mappings the VM made executable), the native heap the launcher and the VM
+ * malloc from, the other anonymous mappings, the stacks and the other files.
+ * The Java heap is anonymous memory like the rest, only NativeMemoryTracking
+ * knows it; the javaHeap group is its committed and reserved size when the
+ * VM ran with it (JNI mode).
+ *
+ * An exec'd VM has been waited for when the launcher exits, its exit
+ * snapshot only has the peak the kernel kept for it.
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseMemory.h"
+
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+	long size;
+	long rss;
+	long pss;
+	long private;
+	long swap;
+} Usage;
+
+enum { LIBJVM, GTK, CDS, CODE_CACHE, NATIVE_HEAP, ANONYMOUS, STACK, FILES, GROUP_COUNT };
+
+static const char* groupNames[] = { "libjvm", "gtk", "cds", "codeCache", "nativeHeap", "anonymous", "stack", "files" };
+
+static const char* gtkLibraries[] = { "/libgtk-", "/libgdk-", "/libgdk_pixbuf-", "/libglib-", "/libgobject-", "/libgio-", NULL };
+
+static char* snapshots = NULL;		/* the snapshots written so far */
+
+static void writeString(FILE* out, const char* value) {
+	fputc('"', out);
+	for (; *value != 0; value++) {
+		unsigned char c = (unsigned char) *value;
+		if (c == '"' || c == '\\')
+			fprintf(out, "\\%c", c);
+		else if (c < 0x20)
+			fprintf(out, "\\u%04x", c);
+		else
+			fputc(c, out);
+	}
+	fputc('"', out);
+}
+
+static int endsWith(const char* str, const char* suffix) {
+	size_t length = strlen(str), suffixLength = strlen(suffix);
+	return length >= suffixLength && strcmp(str + length - suffixLength, suffix) == 0;
+}
+
+static int getGroup(const char* path, const char* perms) {
+	int i;
+
+	if (path[0] == 0)
+		return (perms[2] == 'x') ? CODE_CACHE : ANONYMOUS;
+	if (strcmp(path, "[heap]") == 0)
+		return NATIVE_HEAP;
+	if (strncmp(path, "[stack", 6) == 0)
+		return STACK;
+	if (strncmp(path, "[anon", 5) == 0)
+		return ANONYMOUS;
+	if (path[0] == '[')
+		return FILES;	/* [vdso], [vvar] */
+	if (endsWith(path, "/libjvm.so"))
+		return LIBJVM;
+	if (endsWith(path, ".jsa"))
+		return CDS;
+	for (i = 0; gtkLibraries[i] != NULL; i++) {
+		if (strstr(path, gtkLibraries[i]) != NULL)
+			return GTK;
+	}
+	return FILES;
+}
+
+static FILE* openProcFile(int process, const char* name) {
+	char path[64];
+	sprintf(path, "/proc/%d/%s", process, name);
+	return fopen(path, "r");
+}
+
+/* Add up the mappings of the process by group */
+static int readGroups(int process, Usage groups[]) {
+	char line[4096];
+	char perms[8];
+	char key[32];
+	long value;
+	int offset, group = FILES;
+	FILE* file = openProcFile(process, "smaps");
+
+	if (file == NULL)
+		return -1;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		offset = 0;
+		if (sscanf(line, "%*x-%*x %7s %*x %*s %*u %n", perms, &offset) == 1 && offset > 0) {
+			line[strcspn(line, "\n")] = 0;
+			group = getGroup(line + offset, perms);
+			continue;
+		}
+		if (sscanf(line, "%31[^:]: %ld kB", key, &value) != 2)
+			continue;
+		if (strcmp(key, "Size") == 0)
+			groups[group].size += value;
+		else if (strcmp(key, "Rss") == 0)
+			groups[group].rss += value;
+		else if (strcmp(key, "Pss") == 0)
+			groups[group].pss += value;
+		else if (strcmp(key, "Private_Clean") == 0 || strcmp(key, "Private_Dirty") == 0)
+			groups[group].private += value;
+		else if (strcmp(key, "Swap") == 0)
+			groups[group].swap += value;
+	}
+	fclose(file);
+	return 0;
+}
+
+/* The fields of smaps_rollup, which the kernel adds up for all the mappings */
+static void writeRollup(FILE* out, int process) {
+	char line[256];
+	char key[32];
+	long value;
+	int first = 1;
+	FILE* file = openProcFile(process, "smaps_rollup");
+
+	if (file == NULL)
+		return;
+	fprintf(out, ",\n      \"rollup\": {");
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (sscanf(line, "%31[^: ]: %ld kB", key, &value) != 2)
+			continue;
+		fprintf(out, "%s\"%s\": %ld", first ? "" : ", ", key, value);
+		first = 0;
+	}
+	fprintf(out, "}");
+	fclose(file);
+}
+
+static long getPeakRss(int process) {
+	char line[256];
+	long value = -1;
+	FILE* file = openProcFile(process, "status");
+
+	if (file == NULL)
+		return -1;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (sscanf(line, "VmHWM: %ld kB", &value) == 1)
+			break;
+	}
+	fclose(file);
+	return value;
+}
+
+/* The categories of the NativeMemoryTracking summary:
+ *   Total: reserved=1436374KB, committed=138766KB
+ *   -                 Java Heap (reserved=262144KB, committed=16384KB)
+ * the Java heap also goes into the groups.
+ */
+static void writeNativeMemory(FILE* out, char* summary, long* heapReserved, long* heapCommitted) {
+	char* line = summary;
+	char* next;
+	char* name;
+	char* end;
+	long reserved, committed;
+	int first = 1;
+
+	fprintf(out, ",\n      \"nmt\": {");
+	for (; line != NULL && *line != 0; line = next) {
+		next = strchr(line, '\n');
+		if (next != NULL)
+			*next++ = 0;
+		while (*line == ' ')
+			line++;
+		if (strncmp(line, "Total:", 6) == 0) {
+			name = "Total";
+			end = line + 6;
+		} else if (*line == '-' && (end = strchr(line, '(')) != NULL) {
+			name = line + 1;
+			while (*name == ' ')
+				name++;
+			*end = 0;
+			for (line = end; line > name && line[-1] == ' '; line--)
+				line[-1] = 0;
+			end++;
+		} else {
+			continue;
+		}
+		if (sscanf(end, " reserved=%ldKB, committed=%ldKB", &reserved, &committed) != 2)
+			continue;
+		if (strcmp(name, "Java Heap") == 0) {
+			*heapReserved = reserved;
+			*heapCommitted = committed;
+		}
+		fprintf(out, "%s\n        ", first ? "" : ",");
+		writeString(out, name);
+		fprintf(out, ": {\"reserved\": %ld, \"committed\": %ld}", reserved, committed);
+		first = 0;
+	}
+	fprintf(out, "%s}", first ? "" : "\n      ");
+}
+
+static char* takeSnapshot(char* event, int process, char* nmtSummary) {
+	Usage groups[GROUP_COUNT];
+	struct timespec now;
+	struct rusage usage;
+	long heapReserved = -1, heapCommitted = -1;
+	char* summary = (nmtSummary != NULL) ? strdup(nmtSummary) : NULL;
+	char* result = NULL;
+	size_t length;
+	FILE* out = open_memstream(&result, &length);
+	int i;
+
+	if (out == NULL) {
+		free(summary);
+		return NULL;
+	}
+	clock_gettime(CLOCK_REALTIME, &now);
+	fprintf(out, "    {\"event\": ");
+	writeString(out, event);
+	fprintf(out, ", \"process\": %d, \"time\": %lld", process, (long long) now.tv_sec * 1000 + now.tv_nsec / 1000000);
+	if (process == 0) {
+		/* the largest of the children waited for, which is the VM */
+		if (getrusage(RUSAGE_CHILDREN, &usage) == 0)
+			fprintf(out, ", \"peakRss\": %ld", usage.ru_maxrss);
+		fprintf(out, "}");
+		fclose(out);
+		free(summary);
+		return result;
+	}
+
+	fprintf(out, ", \"peakRss\": %ld", getPeakRss(process));
+	writeRollup(out, process);
+	if (summary != NULL)
+		writeNativeMemory(out, summary, &heapReserved, &heapCommitted);
+	memset(groups, 0, sizeof(groups));
+	if (readGroups(process, groups) == 0) {
+		fprintf(out, ",\n      \"groups\": {");
+		for (i = 0; i < GROUP_COUNT; i++) {
+			fprintf(out, "%s\n        \"%s\": {\"size\": %ld, \"rss\": %ld, \"pss\": %ld, \"private\": %ld, \"swap\": %ld}",
+					i == 0 ? "" : ",", groupNames[i], groups[i].size, groups[i].rss, groups[i].pss, groups[i].private, groups[i].swap);
+		}
+		if (heapCommitted >= 0)
+			fprintf(out, ",\n        \"javaHeap\": {\"reserved\": %ld, \"committed\": %ld}", heapReserved, heapCommitted);
+		fprintf(out, "\n      }");
+	}
+	fprintf(out, "}");
+	fclose(out);
+	free(summary);
+	return result;
+}
+
+int writeMemoryReport(char* reportFile, char* event, int process, char* nmtSummary) {
+	char* snapshot = takeSnapshot(event, process, nmtSummary);
+	FILE* file;
+
+	if (snapshot == NULL)
+		return -1;
+	if (snapshots == NULL) {
+		snapshots = snapshot;
+	} else {
+		snapshots = realloc(snapshots, strlen(snapshots) + 2 + strlen(snapshot) + 1);
+		strcat(snapshots, ",\n");
+		strcat(snapshots, snapshot);
+		free(snapshot);
+	}
+
+	if ((file = fopen(reportFile, "w")) == NULL)
+		return -1;
+	fprintf(file, "{\"launcher\": %d, \"snapshots\": [\n%s\n]}\n", (int) getpid(), snapshots);
+	return fclose(file);
+}
@@ -0,0 +1,30 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_MEMORY_H
+#define ECLIPSE_MEMORY_H
+
+/* Memory footprint report for --launcher.memReport, Linux only */
+
+/**
+ * Add a snapshot of the memory of process to the JSON report in
+ * reportFile, which is rewritten with all the snapshots taken so far.
+ * event names the snapshot (startup, exit).  nmtSummary is the
+ * NativeMemoryTracking summary of the VM in KB, or NULL.  A process of
+ * 0 is one that has been waited for, only its peak is known then.
+ * Returns 0 if success.
+ */
+extern int writeMemoryReport(char* reportFile, char* event, int process, char* nmtSummary);
+
+#endif /* ECLIPSE_MEMORY_H */
@@ -17,14 +17,25 @@
 #include "eclipseCommon.h"
 #include "eclipseUtil.h"
 #include "eclipseJNI.h"
+#ifdef LINUX
+#include "eclipseLog.h"
+#include "eclipseControl.h"
+#endif
 
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <sys/resource.h>
+#include <limits.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+
+#define CONTROL_PUMP 50		/* ms between pumping the splash of an exec'd VM */
 
 #ifdef i386
 #define JAVA_ARCH "i386"
@@ -59,6 +70,17 @@ static const char* jvmLocations [] = { "j9vm", "../jre/bin/j9vm",
 static void adjustLibraryPath( char * vmLibrary );
 static char * findLib(char * command);
 
+/* arguments and result of the vm thread for --launcher.secondThread */
+typedef struct {
+	_TCHAR*  libPath;
+	_TCHAR** vmArgs;
+	_TCHAR** progArgs;
+	_TCHAR*  jarFile;
+	JavaResults* results;
+	int done;
+	pthread_mutex_t lock;
+} StartVMArgs;
+
 char * findVMLibrary( char* command ) {
 	char * lib = findLib(command);
 	if( lib != NULL ) {
@@ -162,9 +184,164 @@ void processVMArgs(_TCHAR **vmargs[] ) {
 	/* nothing yet */
 }
 
+int javaProcess = 0;
+
+/* fork and exec a vm, only the launcher's own vm writes through the log relay */
+static int forkJavaProcess( char* args[], int relay ) {
+	pid_t process = fork();
+	if (process == 0) {
+#ifdef LINUX
+		if (relay)
+			redirectToLogRelay();
+#endif
+		execv(args[0], args);
+		/* The JVM would not start ... return error code to parent process. */
+		_exit(errno);
+	}
+#ifdef LINUX
+	if (relay)
+		closeLogRelayInput();
+#endif
+	return (int) process;
+}
+
+int startJavaProcess( char* args[] ) {
+	int process = forkJavaProcess(args, 1);
+	if (process > 0)
+		javaProcess = process;
+	return process;
+}
+
+int spawnJavaProcess( char* args[] ) {
+	return forkJavaProcess(args, 0);
+}
+
+int waitJavaProcess( int process ) {
+	int status;
+	while (waitpid((pid_t) process, &status, 0) == -1) {
+		if (errno != EINTR)
+			return -1;
+	}
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+#ifdef LINUX
+int serveJavaProcess( int process, int timeout ) {
+	static int pumping = 0;
+	int serving;
+
+	if (getControlPath() == NULL)
+		return relayLog(process, timeout, -1);
+	/* the splash the VM drives through the control channel needs pumping while it is up,
+	 * otherwise the launcher sleeps until the VM writes its output or a message */
+	if (pumping && (timeout < 0 || timeout > CONTROL_PUMP))
+		timeout = CONTROL_PUMP;
+	if (relayLog(process, timeout, getControlFd()))
+		timeout = 0;	/* waited there */
+	serving = serveControl(process, timeout);
+	pumping = dispatchSplashMessages();
+	return serving;
+}
+#endif
+
+/* The stack size for the vm thread, from -Xss if given, else the main thread's limit */
+static size_t getVMStackSize( _TCHAR* vmArgs[] ) {
+	struct rlimit limit = {0, 0};
+	size_t stackSize = 0;
+	int i;
+
+	for (i = 0; vmArgs[i] != NULL; i++) {
+		if (_tcsncmp(vmArgs[i], _T_ECLIPSE("-Xss"), 4) == 0) {
+			char* unit = NULL;
+			stackSize = strtoul(vmArgs[i] + 4, &unit, 10);
+			switch (unit != NULL ? *unit : 0) {
+				case 'g': case 'G': stackSize *= 1024; /* fall through */
+				case 'm': case 'M': stackSize *= 1024; /* fall through */
+				case 'k': case 'K': stackSize *= 1024;
+			}
+		}
+	}
+	if (stackSize == 0 && getrlimit(RLIMIT_STACK, &limit) == 0) {
+		if (limit.rlim_cur != RLIM_INFINITY)
+			stackSize = limit.rlim_cur;
+	}
+	if (stackSize != 0 && stackSize < PTHREAD_STACK_MIN)
+		stackSize = PTHREAD_STACK_MIN;
+	return stackSize;
+}
+
+static void * startVMThread( void * init ) {
+	StartVMArgs* args = (StartVMArgs*) init;
+	JavaResults* results = startJavaJNI(args->libPath, args->vmArgs, args->progArgs, args->jarFile);
+
+	pthread_mutex_lock(&args->lock);
+	args->results = results;
+	args->done = 1;
+	pthread_mutex_unlock(&args->lock);
+	return NULL;
+}
+
+static int isVMThreadDone( StartVMArgs* args ) {
+	int done;
+	pthread_mutex_lock(&args->lock);
+	done = args->done;
+	pthread_mutex_unlock(&args->lock);
+	return done;
+}
+
 JavaResults* startJavaVM( _TCHAR* libPath, _TCHAR* vmArgs[], _TCHAR* progArgs[], _TCHAR* jarFile )
 {
-	return startJavaJNI(libPath, vmArgs, progArgs, jarFile);
+	StartVMArgs args;
+	pthread_t thread;
+	pthread_attr_t attributes;
+	size_t stackSize;
+	struct timespec sleepTime;
+	int error, tick;
+
+	if (!secondThread)
+		return startJavaJNI(libPath, vmArgs, progArgs, jarFile);
+
+	/* --launcher.secondThread: the primordial thread has a fixed stack that the
+	 * vm cannot guard properly, so create the vm on a thread of its own like
+	 * the java launcher does, and keep this thread for the splash screen.
+	 */
+	memset(&args, 0, sizeof(StartVMArgs));
+	args.libPath = libPath;
+	args.vmArgs = vmArgs;
+	args.progArgs = progArgs;
+	args.jarFile = jarFile;
+	pthread_mutex_init(&args.lock, NULL);
+
+	pthread_attr_init(&attributes);
+	stackSize = getVMStackSize(vmArgs);
+	if (stackSize != 0)
+		pthread_attr_setstacksize(&attributes, stackSize);
+	error = pthread_create(&thread, &attributes, &startVMThread, &args);
+	pthread_attr_destroy(&attributes);
+	if (error != 0) {
+		pthread_mutex_destroy(&args.lock);
+		return startJavaJNI(libPath, vmArgs, progArgs, jarFile);
+	}
+
+	/* keep the splash screen alive until Java takes it down or over, then give
+	 * the main context to the vm thread where SWT runs its event loop */
+	sleepTime.tv_sec = 0;
+	sleepTime.tv_nsec = 1e+7; /* 10 milliseconds */
+	acquireMainContext();
+	while (!isVMThreadDone(&args) && dispatchSplashMessages())
+		nanosleep(&sleepTime, NULL);
+	handOverMainContext();
+
+	/* the files to open wait for the GDBus service of the Display, retry about once a second */
+	for (tick = 0; !isVMThreadDone(&args); tick++) {
+		if (tick % 100 == 0 && !serveFileOpen())
+			break;
+		nanosleep(&sleepTime, NULL);
+	}
+
+	pthread_join(thread, NULL);
+	pthread_mutex_destroy(&args.lock);
+	return args.results;
 }
 
 /* returns 1 if the JVM version is >= 9, 0 otherwise */
@@ -35,11 +35,14 @@ extern _TCHAR*  consoleVM;				/* windows needs a different vm executable for the
 #endif
 extern _TCHAR*  shippedVMDir;			/* VM bin directory with separator */
 extern _TCHAR*  exitData;		  		/* exit data set from Java */
+extern _TCHAR*  frameworkLocation;		/* framework bundle found next to the startup jar */
+extern _TCHAR*  startupRecording;		/* JFR recording to stop when startup is complete, set by startupComplete() */
 extern _TCHAR*  vmLibrary;				/* name of the VM shared library */
 extern int		initialArgc;			/* argc originally used to start launcher */
 extern _TCHAR**	initialArgv;			/* argv originally used to start launcher */
 extern _TCHAR*  eeLibPath;				/* library path specified in a .ee file */
 extern int		secondThread;			/* whether or not to start the vm on a second thread */
+extern int		fastExitTimeout;		/* milliseconds the vm may take to shut down, -1 for no limit */
 
 
 /* OS Specific Functions */
@@ -99,6 +102,30 @@ extern _TCHAR * findVMLibrary( _TCHAR * command );
 
 extern void dispatchMessages();
 
+#ifndef _WIN32
+#ifndef MACOSX
+/* dispatch pending splash window events from the main thread while the vm runs on
+ * another one (--launcher.secondThread), returns 0 once the splash is down or has been
+ * handed to Java with getSplashHandle */
+extern int dispatchSplashMessages();
+
+/* --launcher.secondThread: hold the main context while dispatchSplashMessages pumps the splash,
+ * then hand it to the vm thread where SWT iterates it (eclipseGtk.c) */
+extern void acquireMainContext();
+extern void handOverMainContext();
+
+/* pass the files to open to the starting eclipse from the main thread once its context is handed
+ * over, returns 1 while they are still pending */
+extern int serveFileOpen();
+
+/* show the startup progress reported through JNIBridge on the splash window (eclipseGtk.c) */
+extern void updateSplashProgress(int done, int total, const char* label);
+
+/* map the window system libraries ahead of initWindowSystem, may be called from any thread */
+extern void preloadWindowSystem();
+#endif
+#endif
+
 extern jlong getSplashHandle();
 
 extern void takeDownSplash();
@@ -108,6 +135,35 @@ extern void restartLauncher( _TCHAR* program, _TCHAR* args[] );
 /* launch the vm in a separate process and wait for it to finish */
 extern JavaResults* launchJavaVM( _TCHAR* args[] );
 
+#ifndef _WIN32
+#ifndef MACOSX
+/* fork and exec the vm, returns the process id or -1 (eclipseNix.c) */
+extern int startJavaProcess( _TCHAR* args[] );
+
+/* the process last started with startJavaProcess */
+extern int javaProcess;
+
+/* fork and exec a vm of the embedding API (eclipseLaunch.h), returns the process id or -1.
+ * Unlike startJavaProcess it neither sets javaProcess nor uses the launcher's log relay. */
+extern int spawnJavaProcess( _TCHAR* args[] );
+
+/* wait for a process started with startJavaProcess, returns its exit code or -1 */
+extern int waitJavaProcess( int process );
+
+#ifdef LINUX
+/* relay the output (--launcher.logTo) and serve the control channel of a process started with
+ * startJavaProcess for up to timeout ms, returns 0 once there is nothing left to do (eclipseNix.c) */
+extern int serveJavaProcess( int process, int timeout );
+#endif
+
+/* pass files to open to the running eclipse, returns 1 if it took them (eclipseGtk.c) */
+extern int forwardFileOpen( _TCHAR** filePath );
+
+/* startup is complete, release what the window system loaded for the launcher (eclipseGtk.c) */
+extern void releaseWindowSystem();
+#endif
+#endif
+
 /* launch the vm in this process using JNI invocation */
 extern JavaResults* startJavaVM( _TCHAR* libPath, _TCHAR* vmArgs[], _TCHAR* progArgs[], _TCHAR* jarFile );
 
@@ -124,5 +180,14 @@ extern int reuseWorkbench(_TCHAR** filePath, int timeout);
 
 extern _TCHAR* getFolderForApplicationData();
 
+/* called when Java reports that it has finished starting up, implemented in eclipse.c */
+extern void startupComplete();
+
+#ifdef LINUX
+/* called when an exec'd VM reports through its control channel that it has finished
+ * starting up, implemented in eclipse.c */
+extern void controlStartupComplete();
+#endif
+
 #endif /* ECLIPSE_OS_H */
 
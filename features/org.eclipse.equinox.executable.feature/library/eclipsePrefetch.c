@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Page cache prefetching for --launcher.prefetch
+ *
+ * A cold start spends most of its time waiting for the disk: libjvm, the
+ * module image, the CDS archive and a few hundred bundle jars are read in
+ * small random pieces.  While the launcher looks for the VM and the VM is
+ * created, a background thread asks the kernel to read those files ahead
+ * with posix_fadvise(POSIX_FADV_WILLNEED).
+ *
+ * Besides the files the launcher knows about, it prefetches whatever the
+ * previous startup had open or mapped when Java reported that startup was
+ * complete (see startupComplete() in eclipse.c).
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipsePrefetch.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_RECORDED_FILES	8192
+
+typedef struct {
+	char** paths;
+	char*  recordFile;
+} PrefetchArgs;
+
+static void prefetchFile(const char* path) {
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return;
+	posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+	close(fd);
+}
+
+static void * prefetchThread(void * init) {
+	PrefetchArgs* args = (PrefetchArgs*) init;
+	char line[PATH_MAX + 2];
+	FILE* file;
+	int i;
+
+	for (i = 0; args->paths[i] != NULL; i++) {
+		prefetchFile(args->paths[i]);
+		free(args->paths[i]);
+	}
+	free(args->paths);
+
+	if (args->recordFile != NULL && (file = fopen(args->recordFile, "r")) != NULL) {
+		while (fgets(line, sizeof(line), file) != NULL) {
+			line[strcspn(line, "\n")] = 0;
+			if (line[0] == '/')
+				prefetchFile(line);
+		}
+		fclose(file);
+	}
+	free(args->recordFile);
+	free(args);
+	return NULL;
+}
+
+char* getPrefetchRecord(char* programDir) {
+	unsigned long hash = 5381;
+	char* cacheDir = getLauncherCacheDir();
+	char* result;
+	char* c;
+
+	if (cacheDir == NULL)
+		return NULL;
+	/* one record per installation */
+	for (c = programDir; *c != 0; c++)
+		hash = hash * 33 + (unsigned char) *c;
+	result = malloc(strlen(cacheDir) + 32);
+	sprintf(result, "%s/prefetch-%08lx", cacheDir, hash & 0xffffffffUL);
+	free(cacheDir);
+	return result;
+}
+
+void prefetchFiles(char* paths[], char* recordFile) {
+	PrefetchArgs* args = malloc(sizeof(PrefetchArgs));
+	pthread_t thread;
+	pthread_attr_t attributes;
+	int count = 0, i;
+
+	while (paths[count] != NULL)
+		count++;
+	args->paths = malloc((count + 1) * sizeof(char*));
+	for (i = 0; i < count; i++)
+		args->paths[i] = strdup(paths[i]);
+	args->paths[count] = NULL;
+	args->recordFile = (recordFile != NULL) ? strdup(recordFile) : NULL;
+
+	pthread_attr_init(&attributes);
+	pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&thread, &attributes, prefetchThread, args) != 0) {
+		for (i = 0; i < count; i++)
+			free(args->paths[i]);
+		free(args->paths);
+		free(args->recordFile);
+		free(args);
+	}
+	pthread_attr_destroy(&attributes);
+}
+
+static int compareStrings(const void* a, const void* b) {
+	return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+static void addRecordedFile(char** files, int* count, const char* path) {
+	struct stat stats;
+	if (*count >= MAX_RECORDED_FILES || path[0] != '/')
+		return;
+	if (strncmp(path, "/proc/", 6) == 0 || strncmp(path, "/sys/", 5) == 0 || strncmp(path, "/dev/", 5) == 0)
+		return;
+	if (stat(path, &stats) != 0 || !S_ISREG(stats.st_mode))
+		return;	/* also drops "(deleted)" files */
+	files[(*count)++] = strdup(path);
+}
+
+void recordStartupFiles(char* recordFile) {
+	char** files = malloc(MAX_RECORDED_FILES * sizeof(char*));
+	char line[PATH_MAX + 128];
+	char target[PATH_MAX];
+	char* tmpFile;
+	struct dirent* entry;
+	DIR* dir;
+	FILE* file;
+	int count = 0, i;
+
+	/* jars are mostly read through open file descriptors ... */
+	if ((dir = opendir("/proc/self/fd")) != NULL) {
+		while ((entry = readdir(dir)) != NULL) {
+			ssize_t length;
+			if (entry->d_name[0] == '.')
+				continue;
+			sprintf(line, "/proc/self/fd/%s", entry->d_name);
+			length = readlink(line, target, sizeof(target) - 1);
+			if (length <= 0)
+				continue;
+			target[length] = 0;
+			addRecordedFile(files, &count, target);
+		}
+		closedir(dir);
+	}
+
+	/* ... while shared libraries, the module image and the CDS archive are mapped */
+	if ((file = fopen("/proc/self/maps", "r")) != NULL) {
+		while (fgets(line, sizeof(line), file) != NULL) {
+			char* path = strchr(line, '/');
+			if (path == NULL)
+				continue;
+			path[strcspn(path, "\n")] = 0;
+			addRecordedFile(files, &count, path);
+		}
+		fclose(file);
+	}
+
+	qsort(files, count, sizeof(char*), compareStrings);
+
+	tmpFile = malloc(strlen(recordFile) + 16);
+	sprintf(tmpFile, "%s.%d", recordFile, (int) getpid());
+	if ((file = fopen(tmpFile, "w")) != NULL) {
+		for (i = 0; i < count; i++) {
+			if (i == 0 || strcmp(files[i], files[i - 1]) != 0)
+				fprintf(file, "%s\n", files[i]);
+		}
+		if (fclose(file) == 0)
+			rename(tmpFile, recordFile);
+		else
+			unlink(tmpFile);
+	}
+	free(tmpFile);
+
+	for (i = 0; i < count; i++)
+		free(files[i]);
+	free(files);
+}
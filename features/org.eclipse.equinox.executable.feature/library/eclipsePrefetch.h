@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_PREFETCH_H
+#define ECLIPSE_PREFETCH_H
+
+/* Page cache prefetching for --launcher.prefetch, Linux only */
+
+/* environment variable that tells startupComplete() where to record the startup files */
+#define PREFETCH_RECORD_VAR "ECLIPSE_PREFETCH_RECORD"
+
+/**
+ * Returns the file in which the startup files of the installation
+ * in programDir are recorded.  The result must be freed with free().
+ */
+extern char* getPrefetchRecord(char* programDir);
+
+/**
+ * Start a background thread that asks the kernel to read ahead the
+ * NULL terminated list of files, followed by the files listed in the
+ * record file (which may be NULL).  The list is copied.
+ */
+extern void prefetchFiles(char* paths[], char* recordFile);
+
+/**
+ * Write the regular files this process has open or mapped to the
+ * record file, to be prefetched by the next startup.
+ */
+extern void recordStartupFiles(char* recordFile);
+
+#endif /* ECLIPSE_PREFETCH_H */
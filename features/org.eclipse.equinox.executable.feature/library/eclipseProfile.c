@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Phase timings of the launcher for --launcher.profileStartup
+ *
+ * The launcher records a JFR recording of the VM from its creation until
+ * Java takes down the splash screen (see takedown_splash in eclipseJNI.c).
+ * What happened before the VM was created is not in there, so the launcher
+ * times its own phases and hands them to the VM as a system property, which
+ * JFR keeps with the recording (jdk.InitialSystemProperty).
+ *
+ * Built with the systemtap headers, each phase is also a USDT probe, so
+ * perf and bpftrace can mark the phases of a launcher they trace.
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseProfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#endif
+#endif
+
+#define MAX_PHASES	16
+
+typedef struct {
+	char*  name;
+	double time;
+} Phase;
+
+static Phase phases[MAX_PHASES];
+static int   phaseCount = 0;
+
+/* milliseconds since boot */
+static double getTime() {
+	struct timespec now;
+	clock_gettime(CLOCK_BOOTTIME, &now);
+	return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+/* When this process was started in milliseconds since boot, in clock ticks
+ * resolution, or -1 if not known.
+ */
+static double getProcessStart() {
+	char line[1024];
+	unsigned long long start;
+	char* fields;
+	FILE* file;
+	int field;
+
+	if ((file = fopen("/proc/self/stat", "r")) == NULL)
+		return -1;
+	fields = fgets(line, sizeof(line), file);
+	fclose(file);
+	/* the command name may contain anything, the fields start after its last ')' */
+	if (fields == NULL || (fields = strrchr(line, ')')) == NULL)
+		return -1;
+	/* starttime is the 22nd field, the 20th after the command name */
+	for (field = 0; field < 20 && fields != NULL; field++)
+		fields = strchr(fields + 1, ' ');
+	if (fields == NULL || sscanf(fields, " %llu", &start) != 1)
+		return -1;
+	return start * 1000.0 / sysconf(_SC_CLK_TCK);
+}
+
+void markPhase(char* name) {
+#ifdef STAP_PROBE1
+	/* USDT probe sdt_eclipse:phase, for perf probe and bpftrace */
+	STAP_PROBE1(eclipse, phase, name);
+#endif
+	if (phaseCount < MAX_PHASES) {
+		phases[phaseCount].name = name;
+		phases[phaseCount].time = getTime();
+		phaseCount++;
+	}
+}
+
+char* getPhaseTimings() {
+	double start = getProcessStart();
+	char* result;
+	int length = 1, i;
+
+	for (i = 0; i < phaseCount; i++)
+		length += strlen(phases[i].name) + 24;
+	result = malloc(length);
+	result[0] = 0;
+	if (start < 0 && phaseCount > 0)
+		start = phases[0].time;
+	for (i = 0; i < phaseCount; i++) {
+		sprintf(result + strlen(result), "%s%s=%.1f", i > 0 ? "," : "", phases[i].name, phases[i].time - start);
+	}
+	return result;
+}
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_PROFILE_H
+#define ECLIPSE_PROFILE_H
+
+/* Startup profiling for --launcher.profileStartup, Linux only */
+
+/* environment variable that tells startupComplete() which JFR recording to stop */
+#define PROFILE_RECORDING_VAR "ECLIPSE_PROFILE_RECORDING"
+
+/* name of the JFR recording of the startup */
+#define STARTUP_RECORDING "eclipse-startup"
+
+/**
+ * Remember that the launcher has reached the given phase of the
+ * startup.  The name is not copied.
+ */
+extern void markPhase(char* name);
+
+/**
+ * Returns the phases marked so far as a comma separated list of
+ * name=milliseconds, measured from the start of the launcher process.
+ * The result must be freed with free().
+ */
+extern char* getPhaseTimings();
+
+#endif /* ECLIPSE_PROFILE_H */
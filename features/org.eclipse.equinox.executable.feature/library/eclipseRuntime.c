@@ -0,0 +1,345 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Trimmed Java runtime for --launcher.buildRuntime
+ *
+ * A full JDK is several times the size of what a product uses, and the size
+ * of lib/modules is paid in page-ins at every start.  jdeps finds the modules
+ * the product's bundles depend on, jlink builds an image of only those,
+ * without debug information and with compressed resources, and the java of
+ * the image dumps the default CDS archive, so the VM maps its boot classes
+ * instead of loading them.
+ *
+ * Some modules are typically only reached through reflection or the service
+ * loader, which jdeps can't see.  Those are added if the JDK has them.
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipseRuntime.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define RELEASE_FILE	"release"
+#define DEFAULT_EE		"default.ee"
+
+static const char* runtimeModules[] = { "jdk.unsupported", "jdk.zipfs", "jdk.charsets", "jdk.crypto.ec", "jdk.localedata",
+	"jdk.jfr", "jdk.management", NULL };
+
+static char* childPath(const char* dir, const char* name) {
+	char* result = malloc(strlen(dir) + 1 + strlen(name) + 1);
+	sprintf(result, "%s/%s", dir, name);
+	return result;
+}
+
+static char* newMessage(const char* format, const char* arg, int value) {
+	char* result = malloc(strlen(format) + strlen(arg) + 16);
+	sprintf(result, format, arg, value);
+	return result;
+}
+
+/* Run a tool and wait for it.  Its standard output is returned in output unless that
+ * is NULL.  Returns the exit code, -1 if it could not be run.
+ */
+static int runTool(char* args[], char** output) {
+	int fds[2] = { -1, -1 };
+	size_t length = 0, size = 4096;
+	ssize_t count;
+	pid_t process;
+	int status;
+
+	if (output != NULL && pipe(fds) != 0)
+		return -1;
+	process = fork();
+	if (process == 0) {
+		if (output != NULL) {
+			dup2(fds[1], STDOUT_FILENO);
+			close(fds[0]);
+			close(fds[1]);
+		}
+		execv(args[0], args);
+		_exit(127);
+	}
+	if (output != NULL) {
+		close(fds[1]);
+		*output = malloc(size);
+		while (process > 0 && (count = read(fds[0], *output + length, size - length - 1)) != 0) {
+			if (count < 0) {
+				if (errno == EINTR)
+					continue;
+				break;
+			}
+			length += count;
+			if (size - length < 2)
+				*output = realloc(*output, size *= 2);
+		}
+		(*output)[length] = 0;
+		close(fds[0]);
+	}
+	if (process < 0)
+		return -1;
+	while (waitpid(process, &status, 0) == -1) {
+		if (errno != EINTR)
+			return -1;
+	}
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* The JDK directory of a java executable or libjvm */
+static char* getJdkHome(char* vm) {
+	char* home = realpath(vm, NULL);
+	char* end;
+	char* vmDir;
+
+	if (home == NULL)
+		return NULL;
+	end = home + strlen(home);
+	if (end - home > 9 && strcmp(end - 9, "/bin/java") == 0) {
+		end[-9] = 0;
+		return home;
+	}
+	/* lib/<vm>/libjvm.so, the JDK itself may live under a lib directory */
+	end = strrchr(home, '/');
+	if (end != NULL && strcmp(end, "/libjvm.so") == 0) {
+		*end = 0;
+		vmDir = strrchr(home, '/');
+		if (vmDir != NULL && vmDir - home >= 4 && strncmp(vmDir - 4, "/lib", 4) == 0) {
+			vmDir[-4] = 0;
+			return home;
+		}
+	}
+	free(home);
+	return NULL;
+}
+
+/* The value for key in the release file of the JDK, NULL if none */
+static char* getReleaseValue(char* home, const char* key) {
+	char line[4096];
+	char* path = childPath(home, RELEASE_FILE);
+	char* result = NULL;
+	size_t length = strlen(key);
+	FILE* file = fopen(path, "r");
+
+	free(path);
+	if (file == NULL)
+		return NULL;
+	while (result == NULL && fgets(line, sizeof(line), file) != NULL) {
+		char* value = line + length + 1;
+		char* end;
+		if (strncmp(line, key, length) != 0 || line[length] != '=')
+			continue;
+		end = value + strlen(value);
+		while (end > value && (isspace((unsigned char) end[-1]) || end[-1] == '"'))
+			*--end = 0;
+		if (*value == '"')
+			value++;
+		result = strdup(value);
+	}
+	fclose(file);
+	return result;
+}
+
+/* True if module is in the list of modules, separated by separator */
+static int hasModule(char* modules, const char* module, char separator) {
+	size_t length = strlen(module);
+	char* found = modules;
+
+	while ((found = strstr(found, module)) != NULL) {
+		if ((found == modules || found[-1] == separator) && (found[length] == 0 || found[length] == separator))
+			return 1;
+		found += length;
+	}
+	return 0;
+}
+
+/* The modules the jars and the plugins depend on, separated by commas, as jdeps prints them */
+static char* findModules(char* home, char* version, char* jars[], char* pluginsDir, char** msg) {
+	char** args;
+	char* output = NULL;
+	char* modules;
+	char* line;
+	char* jdeps = childPath(home, "bin/jdeps");
+	struct dirent* entry;
+	DIR* dir;
+	int nArgs = 0, size, first, i;
+
+	i = 0;
+	while (jars[i] != NULL)
+		i++;
+	size = i + 256;
+	args = malloc(size * sizeof(char*));
+	args[nArgs++] = jdeps;
+	args[nArgs++] = "--print-module-deps";
+	args[nArgs++] = "--ignore-missing-deps";
+	args[nArgs++] = "--multi-release";
+	args[nArgs++] = version;
+	first = nArgs;
+	for (i = 0; jars[i] != NULL; i++)
+		args[nArgs++] = strdup(jars[i]);
+	if ((dir = opendir(pluginsDir)) != NULL) {
+		/* bundle jars and directories, the jars given are in there too */
+		while ((entry = readdir(dir)) != NULL) {
+			size_t length = strlen(entry->d_name);
+			char* path;
+			struct stat stats;
+			int isJar = length > 4 && strcmp(entry->d_name + length - 4, ".jar") == 0;
+
+			if (entry->d_name[0] == '.')
+				continue;
+			path = childPath(pluginsDir, entry->d_name);
+			if (stat(path, &stats) == 0 && (isJar ? S_ISREG(stats.st_mode) : S_ISDIR(stats.st_mode)) && indexOf(path, jars) == -1) {
+				/* keep room for the NULL */
+				if (nArgs == size - 1) {
+					size *= 2;
+					args = realloc(args, size * sizeof(char*));
+				}
+				args[nArgs++] = path;
+			} else
+				free(path);
+		}
+		closedir(dir);
+	}
+	args[nArgs] = NULL;
+
+	i = runTool(args, &output);
+	for (; first < nArgs; first++)
+		free(args[first]);
+	free(args);
+	if (i != 0) {
+		*msg = newMessage("%s failed with exit code %d", jdeps, i);
+		free(jdeps);
+		free(output);
+		return NULL;
+	}
+	free(jdeps);
+
+	/* the module list is the last line, warnings come before it */
+	while ((line = strrchr(output, '\n')) != NULL && line[1] == 0)
+		*line = 0;
+	line = (line != NULL) ? line + 1 : output;
+	modules = strdup(line[0] != 0 ? line : "java.base");
+	free(output);
+	return modules;
+}
+
+static int writeDefaultEE(char* outputDir, char* home, int jvmLibrary) {
+	char* path = childPath(outputDir, "bin/" DEFAULT_EE);
+	FILE* file = fopen(path, "w");
+
+	free(path);
+	if (file == NULL)
+		return -1;
+	/* relative paths are relative to the .ee file */
+	fprintf(file, "# Java runtime built by --launcher.buildRuntime from %s\n", home);
+	fprintf(file, "-Dee.executable=java\n");
+	if (jvmLibrary)
+		fprintf(file, "-Dee.vm.library=../lib/server/libjvm.so\n");
+	return fclose(file);
+}
+
+int buildRuntime(char* vm, char* jars[], char* pluginsDir, char* outputDir, int jvmLibrary, char** msg) {
+	char* home = getJdkHome(vm);
+	char* jlink;
+	char* java;
+	char* version;
+	char* jdkModules;
+	char* modules;
+	char* output = NULL;
+	char release[16];
+	char* compress;
+	int result, i;
+
+	*msg = NULL;
+	if (home == NULL) {
+		*msg = newMessage("No JDK found for %s", vm, 0);
+		return -1;
+	}
+	jlink = childPath(home, "bin/jlink");
+	version = getReleaseValue(home, "JAVA_VERSION");
+	if (access(jlink, X_OK) != 0 || version == NULL || atoi(version) < 11) {
+		*msg = newMessage("%s is not a JDK 11 or later with jlink and jdeps", home, 0);
+		free(jlink);
+		free(version);
+		free(home);
+		return -1;
+	}
+	if (access(outputDir, F_OK) == 0) {
+		*msg = newMessage("%s already exists", outputDir, 0);
+		free(jlink);
+		free(version);
+		free(home);
+		return -1;
+	}
+	/* jdeps wants the feature release: 17 of 17.0.2 */
+	sprintf(release, "%d", atoi(version));
+	modules = findModules(home, release, jars, pluginsDir, msg);
+	if (modules == NULL) {
+		free(jlink);
+		free(version);
+		free(home);
+		return -1;
+	}
+
+	jdkModules = getReleaseValue(home, "MODULES");
+	for (i = 0; jdkModules != NULL && runtimeModules[i] != NULL; i++) {
+		if (hasModule(jdkModules, runtimeModules[i], ' ') && !hasModule(modules, runtimeModules[i], ',')) {
+			modules = realloc(modules, strlen(modules) + strlen(runtimeModules[i]) + 2);
+			strcat(modules, ",");
+			strcat(modules, runtimeModules[i]);
+		}
+	}
+	free(jdkModules);
+
+	/* zip-<level> replaced the numbered compression levels in 21 */
+	compress = (atoi(version) >= 21) ? "--compress=zip-6" : "--compress=2";
+	{
+		char* args[] = { jlink, "--add-modules", modules, "--output", outputDir, "--strip-debug",
+				"--no-header-files", "--no-man-pages", compress, NULL };
+		result = runTool(args, NULL);
+	}
+	if (result != 0)
+		*msg = newMessage("%s failed with exit code %d", jlink, result);
+	free(modules);
+	free(version);
+	free(jlink);
+
+	if (result == 0) {
+		/* writes lib/server/classes.jsa, which the VM of the image uses by default */
+		java = childPath(outputDir, "bin/java");
+		{
+			char* args[] = { java, "-Xshare:dump", NULL };
+			result = runTool(args, &output);
+		}
+		if (result != 0)
+			*msg = newMessage("%s -Xshare:dump failed with exit code %d", java, result);
+		free(output);
+		free(java);
+	}
+	if (result == 0 && writeDefaultEE(outputDir, home, jvmLibrary) != 0) {
+		*msg = newMessage("Unable to write %s/bin/" DEFAULT_EE, outputDir, 0);
+		result = -1;
+	}
+	free(home);
+	return result;
+}
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_RUNTIME_H
+#define ECLIPSE_RUNTIME_H
+
+/* Trimmed Java runtime for --launcher.buildRuntime, Linux only */
+
+/**
+ * Build a Java runtime image in outputDir, which must not exist yet,
+ * with the modules the given jars and the jars and directories in
+ * pluginsDir need, from the JDK that vm (its java executable or its
+ * libjvm) belongs to.  The image gets a default CDS archive and a
+ * bin/default.ee, so that a launcher finds it as -vm <outputDir>/bin,
+ * or without -vm if outputDir is the jre directory of the installation.
+ * jvmLibrary: True to launch the image through JNI.
+ *
+ * Returns 0 if success, otherwise msg is set to a description of the
+ * problem, to be freed by the caller.
+ */
+extern int buildRuntime(char* vm, char* jars[], char* pluginsDir, char* outputDir, int jvmLibrary, char** msg);
+
+#endif /* ECLIPSE_RUNTIME_H */
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Thread dumps of slow startups for --launcher.stallDump
+ *
+ * Slow starts that happen now and then are hard to explain after the fact.
+ * When startup takes longer than the given threshold, a background thread
+ * samples the VM with thread dumps until Java reports that startup is
+ * complete (see startupComplete() in eclipse.c), and collects them in one
+ * file in the launcher cache directory.
+ *
+ * The dumps are taken through the HotSpot attach mechanism, which works the
+ * same whether the VM runs in the launcher or was exec'd by it: create
+ * .attach_pid<pid>, send SIGQUIT to start the attach listener, then ask for
+ * a thread dump on /tmp/.java_pid<pid>.
+ */
+
+#include "eclipseUnicode.h"
+#include "eclipseUtil.h"
+#include "eclipseStall.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STALL_DUMP_INTERVAL	2		/* seconds between thread dumps */
+#define MAX_STALL_DUMPS		60
+#define ATTACH_TIMEOUT		50		/* times 100ms to wait for the attach listener */
+
+typedef struct {
+	int   fd;
+	int   seconds;
+	char* dumpFile;
+	int   (*vmProcess)();
+} StallArgs;
+
+static pthread_t monitor;
+static int monitorPipe[2] = { -1, -1 };
+
+/* The VM must have its SIGQUIT handler installed, the default action would kill it */
+static int catchesSigquit(int pid) {
+	char line[128];
+	unsigned long long mask = 0;
+	FILE* file;
+
+	sprintf(line, "/proc/%d/status", pid);
+	if ((file = fopen(line, "r")) == NULL)
+		return 0;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (sscanf(line, "SigCgt: %llx", &mask) == 1)
+			break;
+	}
+	fclose(file);
+	return (mask & (1ULL << (SIGQUIT - 1))) != 0;
+}
+
+static int isSocket(const char* path) {
+	struct stat stats;
+	return stat(path, &stats) == 0 && S_ISSOCK(stats.st_mode);
+}
+
+static int threadDump(int pid, FILE* out) {
+	static const char request[] = "1\0threaddump\0\0\0";
+	struct sockaddr_un address;
+	char attachFile[PATH_MAX];
+	char buffer[8192];
+	ssize_t count;
+	int fd, i;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	sprintf(address.sun_path, "/tmp/.java_pid%d", pid);
+	if (!isSocket(address.sun_path)) {
+		if (!catchesSigquit(pid))
+			return -1;
+		/* the VM looks for the trigger file in its working directory, then in /tmp */
+		sprintf(attachFile, "/proc/%d/cwd/.attach_pid%d", pid, pid);
+		if ((fd = open(attachFile, O_WRONLY | O_CREAT, 0600)) < 0) {
+			sprintf(attachFile, "/tmp/.attach_pid%d", pid);
+			if ((fd = open(attachFile, O_WRONLY | O_CREAT, 0600)) < 0)
+				return -1;
+		}
+		close(fd);
+		kill(pid, SIGQUIT);
+		for (i = 0; i < ATTACH_TIMEOUT && !isSocket(address.sun_path); i++)
+			usleep(100000);
+		unlink(attachFile);
+	}
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0)
+		return -1;
+	if (connect(fd, (struct sockaddr*) &address, sizeof(address)) != 0
+			|| write(fd, request, sizeof(request)) != (ssize_t) sizeof(request)) {
+		close(fd);
+		return -1;
+	}
+	/* "<result code>\n<output>" */
+	while ((count = read(fd, buffer, sizeof(buffer))) > 0 || (count < 0 && errno == EINTR)) {
+		if (count > 0)
+			fwrite(buffer, 1, count, out);
+	}
+	close(fd);
+	return 0;
+}
+
+static double elapsed(struct timespec* start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void * monitorThread(void * init) {
+	StallArgs* args = (StallArgs*) init;
+	struct pollfd done = { args->fd, POLLIN, 0 };
+	struct timespec start;
+	FILE* file = NULL;
+	int timeout = args->seconds * 1000;
+	int dumps = 0, result, pid;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (dumps < MAX_STALL_DUMPS) {
+		if ((result = poll(&done, 1, timeout)) < 0 && errno == EINTR)
+			continue;
+		if (result != 0)
+			break;	/* startup complete, or the VM is gone */
+		timeout = STALL_DUMP_INTERVAL * 1000;
+		if ((pid = args->vmProcess()) <= 0)
+			continue;
+		if (file == NULL && (file = fopen(args->dumpFile, "a")) == NULL)
+			break;
+		{
+			char stamp[32];
+			time_t now = time(NULL);
+			struct tm local;
+			strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime_r(&now, &local));
+			fprintf(file, "===== %s, %.1f s after launch, process %d =====\n", stamp, elapsed(&start), pid);
+		}
+		fflush(file);
+		if (threadDump(pid, file) != 0)
+			fprintf(file, "(no thread dump, the VM does not accept attach requests)\n");
+		fprintf(file, "\n");
+		fflush(file);
+		dumps++;
+	}
+	if (file != NULL)
+		fclose(file);
+	free(args->dumpFile);
+	free(args);
+	return NULL;
+}
+
+char* getStallDumpFile() {
+	return getLauncherCacheFile("stall", ".txt");
+}
+
+int startStallMonitor(int seconds, char* dumpFile, int (*vmProcess)()) {
+	StallArgs* args;
+
+	if (monitorPipe[0] >= 0 || seconds <= 0 || pipe(monitorPipe) != 0)
+		return -1;
+	/* only the write end goes to an exec'd VM */
+	fcntl(monitorPipe[0], F_SETFD, FD_CLOEXEC);
+
+	args = malloc(sizeof(StallArgs));
+	args->fd = monitorPipe[0];
+	args->seconds = seconds;
+	args->dumpFile = strdup(dumpFile);
+	args->vmProcess = vmProcess;
+	if (pthread_create(&monitor, NULL, monitorThread, args) != 0) {
+		free(args->dumpFile);
+		free(args);
+		close(monitorPipe[0]);
+		close(monitorPipe[1]);
+		monitorPipe[0] = monitorPipe[1] = -1;
+		return -1;
+	}
+	return monitorPipe[1];
+}
+
+void completeStartup(int fd) {
+	/* the VM keeps its copy open, the launcher closes it in stopStallMonitor() */
+	while (write(fd, "1", 1) < 0 && errno == EINTR) {}
+}
+
+void stopStallMonitor() {
+	if (monitorPipe[0] < 0)
+		return;
+	completeStartup(monitorPipe[1]);
+	pthread_join(monitor, NULL);
+	close(monitorPipe[0]);
+	close(monitorPipe[1]);
+	monitorPipe[0] = monitorPipe[1] = -1;
+}
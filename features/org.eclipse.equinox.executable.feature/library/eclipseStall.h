@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_STALL_H
+#define ECLIPSE_STALL_H
+
+/* Thread dumps of slow startups for --launcher.stallDump, Linux only */
+
+/* environment variable that tells startupComplete() where to report that startup is complete */
+#define STARTUP_FD_VAR "ECLIPSE_STARTUP_FD"
+
+/**
+ * Returns a new file in the launcher cache directory to collect the
+ * thread dumps of this startup in, or NULL if there is no cache
+ * directory.  The result must be freed with free().
+ */
+extern char* getStallDumpFile();
+
+/**
+ * Start watching the startup of the VM about to be launched.  If it is
+ * not complete after the given number of seconds, thread dumps of the
+ * process returned by vmProcess() are appended to dumpFile every few
+ * seconds until it is, or until stopStallMonitor() is called.
+ *
+ * Returns the file descriptor to pass to completeStartup(), -1 if the
+ * monitor could not be started.  The descriptor is inherited by an
+ * exec'd VM.
+ */
+extern int startStallMonitor(int seconds, char* dumpFile, int (*vmProcess)());
+
+/**
+ * Tell the monitor started with the given descriptor that startup is
+ * complete, from the launcher or from the VM it exec'd.
+ */
+extern void completeStartup(int fd);
+
+/**
+ * Stop the monitor, the VM has terminated.
+ */
+extern void stopStallMonitor();
+
+#endif /* ECLIPSE_STALL_H */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* eclipse-stamp: write a launcher ini into the executable
+ *
+ *     eclipse-stamp <launcher> <ini file>
+ *     eclipse-stamp <launcher>              removes the stamped ini
+ *
+ * The launcher is changed in place.  The space reserved for the ini is
+ * found by its magic, not by the section headers, so the tool does not
+ * depend on the word size or byte order of the launcher.
+ */
+
+#define _GNU_SOURCE
+
+#include "eclipseStamp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char* readAll(char* fileName, long* size) {
+	char* data;
+	FILE* file = fopen(fileName, "rb");
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) != 0 || (*size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0) {
+		fclose(file);
+		return NULL;
+	}
+	data = malloc(*size + 1);
+	if (fread(data, 1, *size, file) != (size_t) *size) {
+		free(data);
+		data = NULL;
+	}
+	fclose(file);
+	return data;
+}
+
+int main(int argc, char* argv[]) {
+	char area[EMBEDDED_INI_SIZE - EMBEDDED_INI_OFFSET];
+	char* launcher;
+	char* found;
+	char* ini = NULL;
+	long launcherSize, iniSize = 0;
+	FILE* file;
+
+	if (argc < 2 || argc > 3) {
+		fprintf(stderr, "Usage: %s <launcher> [<ini file>]\n", argv[0]);
+		return 2;
+	}
+	if ((launcher = readAll(argv[1], &launcherSize)) == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+	found = memmem(launcher, launcherSize, EMBEDDED_INI_MAGIC, EMBEDDED_INI_OFFSET);
+	if (found == NULL || found + EMBEDDED_INI_SIZE > launcher + launcherSize
+			|| memmem(found + 1, launcher + launcherSize - found - 1, EMBEDDED_INI_MAGIC, EMBEDDED_INI_OFFSET) != NULL) {
+		fprintf(stderr, "%s: no room for an ini in %s\n", argv[0], argv[1]);
+		return 1;
+	}
+
+	memset(area, 0, sizeof(area));
+	if (argc == 3) {
+		if ((ini = readAll(argv[2], &iniSize)) == NULL) {
+			perror(argv[2]);
+			return 1;
+		}
+		/* keep the terminating 0 */
+		if (iniSize >= (long) sizeof(area) || memchr(ini, 0, iniSize) != NULL) {
+			fprintf(stderr, "%s: %s must be text of less than %d bytes\n", argv[0], argv[2], (int) sizeof(area));
+			return 1;
+		}
+		memcpy(area, ini, iniSize);
+	}
+
+	file = fopen(argv[1], "r+b");
+	if (file == NULL || fseek(file, (found - launcher) + EMBEDDED_INI_OFFSET, SEEK_SET) != 0
+			|| fwrite(area, 1, sizeof(area), file) != sizeof(area) || fclose(file) != 0) {
+		perror(argv[1]);
+		return 1;
+	}
+	free(ini);
+	free(launcher);
+	return 0;
+}
@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+#ifndef ECLIPSE_STAMP_H
+#define ECLIPSE_STAMP_H
+
+/* Launcher ini stamped into the executable, Linux only
+ *
+ * The executable reserves EMBEDDED_INI_SIZE bytes in the EMBEDDED_INI_SECTION
+ * ELF section.  They start with EMBEDDED_INI_MAGIC, followed by the content
+ * of a launcher ini file, 0 terminated, or only zeros if none was stamped.
+ * The section is part of the mapped executable, the launcher reads its
+ * arguments from memory instead of looking for <program>.ini.
+ *
+ * eclipse-stamp (eclipseStamp.c) writes the ini at packaging time.
+ */
+
+#define EMBEDDED_INI_SECTION	".eclipse_ini"
+#define EMBEDDED_INI_MAGIC		"\177ECLIPSE-INI-1"
+#define EMBEDDED_INI_OFFSET		sizeof(EMBEDDED_INI_MAGIC)
+
+#ifndef EMBEDDED_INI_SIZE
+#define EMBEDDED_INI_SIZE		16384
+#endif
+
+#endif /* ECLIPSE_STAMP_H */
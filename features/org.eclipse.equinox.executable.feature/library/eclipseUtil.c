@@ -30,6 +30,9 @@
 #include <unistd.h>
 #include <strings.h>
 #endif
+#ifdef LINUX
+#include <time.h>
+#endif
 
 #include "eclipse-memcpy.h"
 
@@ -336,3 +339,56 @@ int versionCmp(char *ver1, char *ver2)
 
     return versionCmp((char*)(dot1 + 1), (char*)(dot2 + 1) );
 }
+
+#ifdef LINUX
+char* getLauncherCacheDir() {
+	char* base = getenv("XDG_CACHE_HOME");
+	char* home = getenv("HOME");
+	char* result;
+
+	if (base == NULL || base[0] != '/') {
+		if (home == NULL || home[0] == 0)
+			return NULL;
+		base = malloc(strlen(home) + strlen("/.cache") + 1);
+		sprintf(base, "%s/.cache", home);
+		mkdir(base, 0700);
+		result = malloc(strlen(base) + strlen("/eclipse") + 1);
+		sprintf(result, "%s/eclipse", base);
+		free(base);
+	} else {
+		mkdir(base, 0700);
+		result = malloc(strlen(base) + strlen("/eclipse") + 1);
+		sprintf(result, "%s/eclipse", base);
+	}
+	mkdir(result, 0700);
+	return result;
+}
+
+char* getLauncherCacheFile(char* prefix, char* suffix) {
+	char* cacheDir = getLauncherCacheDir();
+	char stamp[32];
+	char* result;
+	time_t now = time(NULL);
+	struct tm local;
+
+	if (cacheDir == NULL)
+		return NULL;
+	strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime_r(&now, &local));
+	result = malloc(strlen(cacheDir) + strlen(prefix) + strlen(suffix) + 48);
+	sprintf(result, "%s/%s-%s-%d%s", cacheDir, prefix, stamp, (int) getpid(), suffix);
+	free(cacheDir);
+	return result;
+}
+
+long getResidentMemory() {
+	long pages = -1;
+	FILE* file = fopen("/proc/self/statm", "r");
+
+	if (file != NULL) {
+		if (fscanf(file, "%*d %ld", &pages) != 1)
+			pages = -1;
+		fclose(file);
+	}
+	return (pages < 0) ? -1 : pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+#endif
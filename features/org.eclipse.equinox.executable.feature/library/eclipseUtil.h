@@ -61,4 +61,19 @@ extern char* getVMVersion( char* vm );
 /* Compare JVM Versions */
 extern int versionCmp( char* ver1, char* ver2 );
 
+#ifdef LINUX
+/* Directory for files the launcher keeps between runs, $XDG_CACHE_HOME/eclipse or
+ * ~/.cache/eclipse.  It is created if needed.  Returns NULL if there is no home directory,
+ * the result must be freed. */
+extern char* getLauncherCacheDir();
+
+/* A new file <prefix>-<date>-<time>-<pid><suffix> in the launcher cache directory for
+ * what this launch wants to leave behind.  Returns NULL if there is no cache directory,
+ * the result must be freed. */
+extern char* getLauncherCacheFile(char* prefix, char* suffix);
+
+/* Resident set size of this process in kB, -1 if not known. */
+extern long getResidentMemory();
+#endif
+
 #endif /* ECLIPSE_UTIL_H */
@@ -0,0 +1,535 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* eclipse-fileopen-bench: how long the launcher takes to hand a file to a running eclipse
+ *
+ *     eclipse-fileopen-bench [-launcher <eclipse>] [-count <n>] [-interval <ms>]
+ *                            [-startupDelay <ms>] [-state running|startup|both]
+ *                            [-- <launcher arguments>]
+ *
+ * The benchmark starts a private dbus-daemon --session and plays SWT on it: it
+ * registers org.eclipse.swt with the FileOpen method of /org/eclipse/swt the
+ * way Display does.  It then runs the launcher as "eclipse --launcher.openFile
+ * <file> -data <workspace>" count times, one every interval ms, and measures
+ * for each the time from the start of the launcher until FileOpen got the file
+ * and until the launcher exited, and the CPU time the launcher used.
+ *
+ * The benchmark holds the lock of the workspace, like the instance that owns
+ * it.  In the "running" state org.eclipse.swt is on the bus from the start, a
+ * launcher finds it in reuseWorkbench() and calls gdbus_call_FileOpen() right
+ * away.  In the "startup" state the name only appears startupDelay ms after
+ * the first launcher started, like a workbench that is still coming up: the
+ * launchers find the workspace locked and try again every second (see
+ * checkWorkspaceLock() in eclipse.c).
+ *
+ * GTK needs a display.  Without DISPLAY the benchmark starts Xvfb, run it with
+ * the display of the session otherwise.  XDG_RUNTIME_DIR points to a directory
+ * of the benchmark so that the launchers don't find the socket of a running
+ * instance (see eclipseHandoff.c) and go through D-Bus.
+ */
+
+#define _GNU_SOURCE
+
+#include <gio/gio.h>
+
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SWT_SERVICE		"org.eclipse.swt"
+#define SWT_OBJECT		"/org/eclipse/swt"
+#define HELPER_TIMEOUT	10000	/* ms to wait for dbus-daemon and Xvfb to tell where they are */
+
+static const gchar swtInterface[] =
+	"<node>"
+	"  <interface name='org.eclipse.swt'>"
+	"    <method name='FileOpen'>"
+	"      <arg type='as' name='fileNames' direction='in'/>"
+	"    </method>"
+	"  </interface>"
+	"</node>";
+
+typedef struct {
+	pid_t  process;
+	double started;		/* ms */
+	double delivered;	/* ms, 0 if FileOpen didn't get the file */
+	double exited;		/* ms */
+	int    status;
+	struct rusage usage;
+} Launch;
+
+/* what FileOpen received, the launches of the current state */
+static pthread_mutex_t launchLock = PTHREAD_MUTEX_INITIALIZER;
+static Launch* launches = NULL;
+static int     launchCount = 0;
+static int     unexpectedFiles = 0;
+
+static GDBusConnection* connection = NULL;
+static GMainLoop* serviceLoop = NULL;
+static char* busAddress = NULL;
+
+static char* workDir = NULL;
+
+static double now() {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+/* The files are <workDir>/files/<index>.txt */
+static void fileOpen(GDBusConnection* bus, const gchar* sender, const gchar* path, const gchar* interface,
+		const gchar* method, GVariant* parameters, GDBusMethodInvocation* invocation, gpointer data) {
+	double received = now();
+	const gchar** files = NULL;
+	int i;
+
+	g_variant_get(parameters, "(^a&s)", &files);
+	pthread_mutex_lock(&launchLock);
+	for (i = 0; files != NULL && files[i] != NULL; i++) {
+		const char* name = strrchr(files[i], '/');
+		int index = (name != NULL) ? atoi(name + 1) : -1;
+		if (index >= 0 && index < launchCount && launches[index].delivered == 0)
+			launches[index].delivered = received;
+		else
+			unexpectedFiles++;
+	}
+	pthread_mutex_unlock(&launchLock);
+	g_free(files);
+	g_dbus_method_invocation_return_value(invocation, NULL);
+}
+
+static const GDBusInterfaceVTable swtVTable = { fileOpen, NULL, NULL };
+
+static void* runService(void* data) {
+	GMainContext* context = (GMainContext*) data;
+
+	g_main_context_push_thread_default(context);
+	g_main_loop_run(serviceLoop);
+	g_main_context_pop_thread_default(context);
+	return NULL;
+}
+
+/* Connect to the bus and serve FileOpen on a thread of its own, the name is not taken yet */
+static int startService(pthread_t* thread) {
+	GMainContext* context = g_main_context_new();
+	GDBusNodeInfo* node;
+	GError* error = NULL;
+
+	node = g_dbus_node_info_new_for_xml(swtInterface, &error);
+	if (node != NULL) {
+		/* method calls are dispatched to the thread default context of the registration */
+		g_main_context_push_thread_default(context);
+		connection = g_dbus_connection_new_for_address_sync(busAddress,
+				G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+				NULL, NULL, &error);
+		if (connection != NULL)
+			g_dbus_connection_register_object(connection, SWT_OBJECT, node->interfaces[0], &swtVTable, NULL, NULL, &error);
+		g_main_context_pop_thread_default(context);
+		g_dbus_node_info_unref(node);
+	}
+	if (error != NULL) {
+		fprintf(stderr, "Could not serve %s: %s\n", SWT_SERVICE, error->message);
+		g_error_free(error);
+		return -1;
+	}
+	serviceLoop = g_main_loop_new(context, FALSE);
+	g_main_context_unref(context);
+	return pthread_create(thread, NULL, runService, context);
+}
+
+/* RequestName or ReleaseName of org.eclipse.swt */
+static int callBus(const char* method) {
+	GError* error = NULL;
+	GVariant* parameters = (strcmp(method, "RequestName") == 0)
+			? g_variant_new("(su)", SWT_SERVICE, 4 /* DBUS_NAME_FLAG_DO_NOT_QUEUE */)
+			: g_variant_new("(s)", SWT_SERVICE);
+	GVariant* result = g_dbus_connection_call_sync(connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+			"org.freedesktop.DBus", method, parameters, G_VARIANT_TYPE("(u)"), G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+
+	if (result == NULL) {
+		fprintf(stderr, "%s %s failed: %s\n", method, SWT_SERVICE, error->message);
+		g_error_free(error);
+		return -1;
+	}
+	g_variant_unref(result);
+	return 0;
+}
+
+/* Start a helper that writes where it is to the descriptor given by "%d" in its arguments,
+ * returns the first line it writes or NULL.
+ */
+static char* startHelper(char* args[], pid_t* process) {
+	static char line[256];
+	char fdArg[64];
+	char* format = NULL;
+	struct pollfd ready;
+	ssize_t count, length = 0;
+	int channel[2], i;
+
+	if (pipe2(channel, O_CLOEXEC) != 0)
+		return NULL;
+	for (i = 0; args[i] != NULL; i++) {
+		if (strstr(args[i], "%d") != NULL) {
+			format = args[i];
+			snprintf(fdArg, sizeof(fdArg), format, channel[1]);
+			args[i] = fdArg;
+		}
+	}
+	*process = fork();
+	if (*process == 0) {
+		int flags = fcntl(channel[1], F_GETFD);
+		fcntl(channel[1], F_SETFD, flags & ~FD_CLOEXEC);
+		execvp(args[0], args);
+		_exit(127);
+	}
+	for (i = 0; args[i] != NULL; i++) {
+		if (args[i] == fdArg)
+			args[i] = format;
+	}
+	close(channel[1]);
+	if (*process < 0) {
+		close(channel[0]);
+		return NULL;
+	}
+
+	ready.fd = channel[0];
+	ready.events = POLLIN;
+	while (length < (ssize_t) sizeof(line) - 1 && memchr(line, '\n', length) == NULL) {
+		if (poll(&ready, 1, HELPER_TIMEOUT) <= 0)
+			break;
+		if ((count = read(channel[0], line + length, sizeof(line) - 1 - length)) <= 0)
+			break;
+		length += count;
+	}
+	close(channel[0]);
+	line[length] = 0;
+	if (memchr(line, '\n', length) == NULL) {
+		fprintf(stderr, "%s did not start\n", args[0]);
+		kill(*process, SIGTERM);
+		waitpid(*process, NULL, 0);
+		*process = 0;
+		return NULL;
+	}
+	line[strcspn(line, "\n")] = 0;
+	return line;
+}
+
+static void stopHelper(pid_t process) {
+	if (process > 0) {
+		kill(process, SIGTERM);
+		waitpid(process, NULL, 0);
+	}
+}
+
+/* CPU time of the process in ms */
+static double getProcessCpu(pid_t process) {
+	char path[64];
+	char stat[1024];
+	char* fields;
+	unsigned long user = 0, system = 0;
+	FILE* file;
+
+	sprintf(path, "/proc/%d/stat", (int) process);
+	if ((file = fopen(path, "r")) == NULL)
+		return 0;
+	if (fgets(stat, sizeof(stat), file) != NULL && (fields = strrchr(stat, ')')) != NULL)
+		sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &user, &system);
+	fclose(file);
+	return (user + system) * 1000.0 / sysconf(_SC_CLK_TCK);
+}
+
+/* Take the lock Equinox takes on .metadata/.lock, returns the descriptor that keeps it */
+static int lockWorkspace(char* workspace) {
+	struct flock lock;
+	char path[PATH_MAX];
+	int fd;
+
+	snprintf(path, sizeof(path), "%s/.metadata", workspace);
+	mkdir(workspace, 0700);
+	mkdir(path, 0700);
+	strcat(path, "/.lock");
+	if ((fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600)) < 0)
+		return -1;
+	memset(&lock, 0, sizeof(lock));
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	if (fcntl(fd, F_SETLK, &lock) != 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static pid_t startLauncher(char* launcher, char* extraArgs[], int index) {
+	char file[PATH_MAX];
+	char workspace[PATH_MAX];
+	char** args;
+	int argCount = 0, i;
+	pid_t process;
+	FILE* stream;
+
+	snprintf(file, sizeof(file), "%s/files/%d.txt", workDir, index);
+	if ((stream = fopen(file, "w")) != NULL)
+		fclose(stream);
+	snprintf(workspace, sizeof(workspace), "%s/workspace", workDir);
+	for (i = 0; extraArgs[i] != NULL; i++)
+		argCount++;
+	args = malloc((argCount + 6) * sizeof(char*));
+	args[0] = launcher;
+	args[1] = "--launcher.openFile";
+	args[2] = file;
+	args[3] = "-data";
+	args[4] = workspace;
+	memcpy(args + 5, extraArgs, (argCount + 1) * sizeof(char*));
+
+	process = fork();
+	if (process == 0) {
+		int null = open("/dev/null", O_RDWR);
+		dup2(null, STDIN_FILENO);
+		dup2(null, STDOUT_FILENO);
+		execv(launcher, args);
+		_exit(127);
+	}
+	free(args);
+	return process;
+}
+
+/* Reap the launchers that are done, waits for one if block */
+static int reapLaunchers(int block) {
+	struct rusage usage;
+	int status, reaped = 0, i;
+	pid_t process;
+
+	while ((process = wait4(-1, &status, block && reaped == 0 ? 0 : WNOHANG, &usage)) > 0) {
+		pthread_mutex_lock(&launchLock);
+		for (i = 0; i < launchCount; i++) {
+			if (launches[i].process == process) {
+				launches[i].exited = now();
+				launches[i].status = status;
+				launches[i].usage = usage;
+				launches[i].process = 0;
+				reaped++;
+			}
+		}
+		pthread_mutex_unlock(&launchLock);
+	}
+	return reaped;
+}
+
+static int compareTimes(const void* a, const void* b) {
+	double difference = *(const double*) a - *(const double*) b;
+	return (difference > 0) - (difference < 0);
+}
+
+static void printTimes(char* label, double* times, int count) {
+	if (count == 0) {
+		printf("  %-9s -\n", label);
+		return;
+	}
+	qsort(times, count, sizeof(double), compareTimes);
+	printf("  %-9s min %7.1f  median %7.1f  p90 %7.1f  p99 %7.1f  max %7.1f\n", label,
+			times[0], times[count / 2], times[(count * 9) / 10], times[(count * 99) / 100], times[count - 1]);
+}
+
+static double toMs(struct timeval time) {
+	return time.tv_sec * 1000.0 + time.tv_usec / 1000.0;
+}
+
+static int runState(char* state, char* launcher, char* extraArgs[], int count, int interval, int startupDelay, pid_t daemon) {
+	struct timespec tick = { 0, 1000000L };	/* how often the exits are looked for */
+	double* handoff = malloc(count * sizeof(double));
+	double* exited = malloc(count * sizeof(double));
+	double start, user = 0, system = 0, busCpu;
+	int startup = strcmp(state, "startup") == 0;
+	int running = 0, delivered = 0, failed = 0, named = !startup, i;
+
+	pthread_mutex_lock(&launchLock);
+	memset(launches, 0, count * sizeof(Launch));
+	launchCount = count;
+	unexpectedFiles = 0;
+	pthread_mutex_unlock(&launchLock);
+	if (named && callBus("RequestName") != 0)
+		return -1;
+
+	busCpu = getProcessCpu(daemon);
+	start = now();
+	for (i = 0; i < count || running > 0; ) {
+		if (!named && now() - start >= startupDelay) {
+			if (callBus("RequestName") != 0)
+				break;
+			named = 1;
+		}
+		if (i < count && now() - start >= (double) i * interval) {
+			launches[i].started = now();
+			launches[i].process = startLauncher(launcher, extraArgs, i);
+			if (launches[i].process > 0)
+				running++;
+			i++;
+		} else if (i == count && named) {
+			/* only the exits are left to wait for */
+			running -= reapLaunchers(1);
+		} else {
+			running -= reapLaunchers(0);
+			nanosleep(&tick, NULL);
+		}
+	}
+	busCpu = getProcessCpu(daemon) - busCpu;
+	callBus("ReleaseName");
+
+	pthread_mutex_lock(&launchLock);
+	for (i = 0; i < count; i++) {
+		Launch* launch = &launches[i];
+		if (launch->delivered > 0)
+			handoff[delivered++] = launch->delivered - launch->started;
+		if (launch->delivered == 0 || !WIFEXITED(launch->status) || WEXITSTATUS(launch->status) != 0)
+			failed++;
+		exited[i] = launch->exited - launch->started;
+		user += toMs(launch->usage.ru_utime);
+		system += toMs(launch->usage.ru_stime);
+	}
+	pthread_mutex_unlock(&launchLock);
+
+	printf("%s: %d launchers %d ms apart", state, count, interval);
+	if (startup)
+		printf(", %s on the bus after %d ms", SWT_SERVICE, startupDelay);
+	printf("\n  %d files delivered, %d launchers failed", delivered, failed);
+	if (unexpectedFiles > 0)
+		printf(", %d unexpected files", unexpectedFiles);
+	printf("\n");
+	printTimes("handoff", handoff, delivered);
+	printTimes("exit", exited, count);
+	printf("  cpu       launcher %.1f user + %.1f system ms per launch, dbus-daemon %.1f ms in all\n",
+			user / count, system / count, busCpu);
+	free(handoff);
+	free(exited);
+	return failed > 0 ? 1 : 0;
+}
+
+static int removeEntry(const char* path, const struct stat* stats, int type, struct FTW* ftw) {
+	return remove(path);
+}
+
+int main(int argc, char* argv[]) {
+	char* launcher = "./eclipse";
+	char* state = "both";
+	char* emptyArgs[] = { NULL };
+	char** extraArgs = emptyArgs;
+	char* daemonArgs[] = { "dbus-daemon", "--session", "--nofork", "--print-address=%d", NULL };
+	char* xvfbArgs[] = { "Xvfb", "-displayfd", "%d", "-nolisten", "tcp", NULL };
+	char template[] = "/tmp/eclipse-fileopen-XXXXXX";
+	char path[PATH_MAX];
+	char* value;
+	int count = 50, interval = 20, startupDelay = 3000;
+	int lockFd, result = 0, i;
+	pid_t daemon = 0, xvfb = 0;
+	pthread_t serviceThread;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--") == 0) {
+			extraArgs = argv + i + 1;
+			break;
+		}
+		if (i + 1 >= argc)
+			break;
+		if (strcmp(argv[i], "-launcher") == 0)
+			launcher = argv[++i];
+		else if (strcmp(argv[i], "-count") == 0)
+			count = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-interval") == 0)
+			interval = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-startupDelay") == 0)
+			startupDelay = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-state") == 0)
+			state = argv[++i];
+		else
+			break;
+	}
+	if ((i < argc && extraArgs == emptyArgs) || count <= 0 || interval < 0
+			|| (strcmp(state, "running") != 0 && strcmp(state, "startup") != 0 && strcmp(state, "both") != 0)) {
+		fprintf(stderr, "Usage: %s [-launcher <eclipse>] [-count <n>] [-interval <ms>] [-startupDelay <ms>]\n"
+				"       [-state running|startup|both] [-- <launcher arguments>]\n", argv[0]);
+		return 2;
+	}
+	if (access(launcher, X_OK) != 0) {
+		perror(launcher);
+		return 2;
+	}
+	launcher = realpath(launcher, NULL);
+
+	if ((workDir = mkdtemp(template)) == NULL) {
+		perror(template);
+		return 1;
+	}
+	snprintf(path, sizeof(path), "%s/files", workDir);
+	mkdir(path, 0700);
+	snprintf(path, sizeof(path), "%s/run", workDir);
+	mkdir(path, 0700);
+	setenv("XDG_RUNTIME_DIR", path, 1);
+	snprintf(path, sizeof(path), "%s/workspace", workDir);
+	lockFd = lockWorkspace(path);
+	launches = malloc(count * sizeof(Launch));
+
+	if ((value = startHelper(daemonArgs, &daemon)) == NULL) {
+		result = 1;
+		goto cleanup;
+	}
+	busAddress = strdup(value);
+	setenv("DBUS_SESSION_BUS_ADDRESS", busAddress, 1);
+	if (getenv("DISPLAY") == NULL) {
+		if ((value = startHelper(xvfbArgs, &xvfb)) == NULL) {
+			result = 1;
+			goto cleanup;
+		}
+		snprintf(path, sizeof(path), ":%s", value);
+		setenv("DISPLAY", path, 1);
+	}
+	if (lockFd < 0 || startService(&serviceThread) != 0) {
+		result = 1;
+		goto cleanup;
+	}
+
+	printf("%s on %s, display %s\n", launcher, busAddress, getenv("DISPLAY"));
+	if (strcmp(state, "startup") != 0)
+		result |= runState("running", launcher, extraArgs, count, interval, startupDelay, daemon);
+	if (strcmp(state, "running") != 0)
+		result |= runState("startup", launcher, extraArgs, count, interval, startupDelay, daemon);
+
+	g_main_loop_quit(serviceLoop);
+	pthread_join(serviceThread, NULL);
+	g_object_unref(connection);
+	g_main_loop_unref(serviceLoop);
+
+cleanup:
+	stopHelper(xvfb);
+	stopHelper(daemon);
+	if (lockFd >= 0)
+		close(lockFd);
+	nftw(workDir, removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+	free(launches);
+	free(busAddress);
+	free(launcher);
+	return result;
+}
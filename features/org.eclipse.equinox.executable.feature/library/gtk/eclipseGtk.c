@@ -34,6 +34,7 @@
 #include <locale.h>
 #include <semaphore.h>
 #include <fcntl.h>
+#include <pthread.h>
 
 /* Global Variables */
 char*  defaultVM     = "java";
@@ -47,11 +48,20 @@ static char*  argVM_JAVA[]        = { NULL };
 /* Define local variables . */
 static GtkWidget*	splashHandle = 0;
 static GtkWidget*   shellHandle = 0;
+static int			splashHandedOut = 0;	/* Java owns the splash window through getSplashHandle() */
+static GtkWidget*	splashBox = 0;			/* the image and, once progress is reported, the progress bar */
+static GtkWidget*	progressBar = 0;
+
+/* with --launcher.secondThread the splash is used from the main thread and the vm thread */
+static pthread_mutex_t splashLock;
+static pthread_once_t splashLockOnce = PTHREAD_ONCE_INIT;
 
 static _TCHAR** openFilePath = NULL; /* the files we want to open */
 static int openFileTimeout = 60; 	 /* number of seconds to wait before timeout */
 static int filesPassedToSWT = 0;	 /* set to 1 on success */
 static const int FILEOPEN_RETRY_TIMEOUT_MS = 1000;
+static guint openFileTimer = 0;		 /* gdbus_FileOpen_TimerProc on the main context */
+static int ownsMainContext = 0;		 /* the main thread holds the main context, see acquireMainContext */
 
 /** GDBus related */
 static const gchar GDBUS_SERVICE[] = "org.eclipse.swt";
@@ -62,7 +72,7 @@ GDBusProxy *gdbus_proxy = NULL;
 gboolean gdbus_initProxy ();
 gboolean gdbus_testConnection();
 gboolean gdbus_FileOpen_TimerProc(gpointer data);
-gboolean gdbus_call_FileOpen ();
+gboolean gdbus_call_FileOpen (_TCHAR** filePath);
 
 /*
  * Deals with opening files passed to eclipse.  e.g: ./eclipse /myfile
@@ -84,11 +94,11 @@ gboolean reuseWorkbench(_TCHAR** filePath, int timeout) {
 
 	// If eclipse already open, just pass files.
 	if (gdbus_testConnection()) {
-		return gdbus_call_FileOpen();
+		return gdbus_call_FileOpen(openFilePath);
 	} else {
 		// Otherwise add a timer that will keep trying to pass files to eclipse for a few minutes until it succeeds or times out.
 		// Note, the while loop in launchJavaVM() ensures the launcher doesn't quit before the timer expired.
-		gtk.g_timeout_add(FILEOPEN_RETRY_TIMEOUT_MS, gdbus_FileOpen_TimerProc, 0);
+		openFileTimer = gtk.g_timeout_add(FILEOPEN_RETRY_TIMEOUT_MS, gdbus_FileOpen_TimerProc, 0);
 		return 0;
 	}
 }
@@ -157,12 +167,15 @@ gboolean gdbus_testConnection() {
  * Timer ends when it returns false. (Files passed to eclipse or timeout).
  */
 gboolean gdbus_FileOpen_TimerProc(gpointer data) {
-	if (openFileTimeout == 0)
+	if (openFileTimeout == 0 || filesPassedToSWT) {
+		openFileTimer = 0;
 		return 0; // stop timer.
+	}
 	openFileTimeout--;
 	if (gdbus_testConnection()) {
-		gdbus_call_FileOpen();
+		gdbus_call_FileOpen(openFilePath);
 		filesPassedToSWT = 1;
+		openFileTimer = 0;
 		return 0; // stop timer.
 	}
 	return 1; // run timer again.
@@ -175,7 +188,7 @@ gboolean gdbus_FileOpen_TimerProc(gpointer data) {
  * Return: FALSE (0) Call did not work. Probably eclipse not fired up yet. (try again later)
  *         TRUE (1) GDBus call completed successfully.
  */
-gboolean gdbus_call_FileOpen () {
+gboolean gdbus_call_FileOpen (_TCHAR** filePath) {
 	if (!gdbus_initProxy())
 		return 0;
 
@@ -185,8 +198,8 @@ gboolean gdbus_call_FileOpen () {
 	builder = gtk.g_variant_builder_new ((const GVariantType *) "as");  // as = G_VARIANT_TYPE_STRING_ARRAY
 
 	int i = -1;
-	while (openFilePath[++i] != NULL) {
-			gtk.g_variant_builder_add (builder, (const gchar *) (const GVariantType *) "s", (const gchar *) openFilePath[i]);  // s = G_VARIANT_TYPE_STRING
+	while (filePath[++i] != NULL) {
+			gtk.g_variant_builder_add (builder, (const gchar *) (const GVariantType *) "s", (const gchar *) filePath[i]);  // s = G_VARIANT_TYPE_STRING
 	}
 
 	paramaters = gtk.g_variant_new ("(as)", builder);
@@ -224,8 +237,208 @@ float scaleFactor () {
 	return scaleFactor;
 }
 
+static int _showSplash( const char* featureImage );
+static void showSplashProgress();
+
+static void initSplashLock() {
+	pthread_mutexattr_t attributes;
+	pthread_mutexattr_init(&attributes);
+	pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&splashLock, &attributes);
+	pthread_mutexattr_destroy(&attributes);
+}
+
+static void lockSplash() {
+	pthread_once(&splashLockOnce, initSplashLock);
+	pthread_mutex_lock(&splashLock);
+}
+
+static void unlockSplash() {
+	pthread_mutex_unlock(&splashLock);
+}
+
+/*
+ * Pass files another launcher handed over to us (see eclipseHandoff.c) to the running eclipse.
+ * Runs on the handoff thread: GDBus may be used from any thread, GTK itself is not initialized here.
+ *
+ * Return: 1 files passed to eclipse, 0 eclipse is not listening (headless, not up yet...).
+ */
+int forwardFileOpen(_TCHAR** filePath) {
+	int result;
+
+	lockSplash();	/* the splash may be loading GTK on the main thread */
+	result = loadGtk() == 0 && gdbus_testConnection() && gdbus_call_FileOpen(filePath);
+	unlockSplash();
+	return result;
+}
+
+/*
+ * --launcher.secondThread: the main thread pumps the splash while SWT creates its Display
+ * on the VM thread.  Both iterate the default main context, so the main thread holds it
+ * until Java takes the splash down or over, SWT blocks in its event loop meanwhile.
+ */
+void acquireMainContext() {
+	lockSplash();
+	if (!ownsMainContext && gtkInitialized)
+		ownsMainContext = gtk.g_main_context_acquire(0);
+	unlockSplash();
+}
+
+/*
+ * Hand the main context to the VM thread.  The file open timer must not follow it: on
+ * the thread of the Display it would call the Display's own GDBus service and block
+ * it, serveFileOpen passes the files from the main thread instead.
+ */
+void handOverMainContext() {
+	lockSplash();
+	if (openFileTimer != 0) {
+		gtk.g_source_remove(openFileTimer);
+		openFileTimer = 0;
+	}
+	if (ownsMainContext) {
+		gtk.g_main_context_release(0);
+		ownsMainContext = 0;
+	}
+	unlockSplash();
+}
+
+/*
+ * Try once to pass the files of reuseWorkbench to the starting eclipse, to be called about
+ * every FILEOPEN_RETRY_TIMEOUT_MS once the main context is handed over.
+ *
+ * Return: 1 the files are still pending, 0 they were passed or timed out.
+ */
+int serveFileOpen() {
+	int pending;
+
+	lockSplash();
+	pending = openFilePath != NULL && gtkInitialized && gdbus_FileOpen_TimerProc(0);
+	unlockSplash();
+	return pending;
+}
+
+/*
+ * Startup is complete: drop the GDBus proxy and the GTK libraries unless a file open
+ * is still pending.  The libraries are only unloaded when nothing initialized them,
+ * that is when no splash was shown.  Once gtk_init_with_args ran GTK can't go: its
+ * types stay registered with GObject (which the dynamic loader never unloads), GDBus
+ * keeps a worker thread, and SWT loads the same libraries and expects that state, so
+ * a dlclose would give nothing back and SWT could not initialize GTK again.
+ */
+void releaseWindowSystem() {
+	lockSplash();
+	if (openFilePath == NULL || filesPassedToSWT || openFileTimeout == 0) {
+		if (gdbus_proxy != NULL) {
+			gtk.g_object_unref(gdbus_proxy);
+			gdbus_proxy = NULL;
+		}
+		if (!gtkInitialized)
+			unloadGtk();
+	}
+	unlockSplash();
+}
+
+/*
+ * Called on a thread of its own while the launcher looks for the VM, see startDiscovery
+ * in eclipse.c.  Only the libraries are loaded, GTK is initialized on the main thread.
+ */
+void preloadWindowSystem() {
+	preloadGtk();
+}
+
+/*
+ * Startup progress reported through JNIBridge.updateSplashProgress().  With --launcher.secondThread
+ * the VM thread reports while the main thread holds the splash lock to pump events, so the
+ * progress is published without the lock: the sequence is odd while it is written, and a
+ * reader retries until it reads the same even sequence before and after.
+ */
+static struct {
+	int sequence;
+	int done;
+	int total;
+	char label[128];
+} splashProgress;
+static int shownProgress = 0;	/* the sequence the progress bar shows */
+
+void updateSplashProgress(int done, int total, const char* label) {
+	int sequence = __atomic_load_n(&splashProgress.sequence, __ATOMIC_RELAXED);
+	size_t length = 0;
+
+	/* another thread is reporting, that progress will do */
+	if ((sequence & 1) || !__atomic_compare_exchange_n(&splashProgress.sequence, &sequence, sequence + 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		return;
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	splashProgress.done = done;
+	splashProgress.total = total;
+	if (label != NULL) {
+		length = strlen(label);
+		if (length >= sizeof(splashProgress.label)) {
+			/* don't cut a UTF-8 sequence */
+			length = sizeof(splashProgress.label) - 1;
+			while (length > 0 && (label[length] & 0xC0) == 0x80)
+				length--;
+		}
+		memcpy(splashProgress.label, label, length);
+	}
+	splashProgress.label[length] = 0;
+	__atomic_store_n(&splashProgress.sequence, sequence + 2, __ATOMIC_RELEASE);
+
+	/* with --launcher.secondThread the main thread shows it the next time it pumps */
+	if (!secondThread)
+		dispatchMessages();
+}
+
+/* Show the latest progress on the splash, called with the splash lock held */
+static void showSplashProgress() {
+	char label[sizeof(splashProgress.label)];
+	int sequence, done, total;
+	double fraction;
+
+	do {
+		sequence = __atomic_load_n(&splashProgress.sequence, __ATOMIC_ACQUIRE);
+		done = splashProgress.done;
+		total = splashProgress.total;
+		memcpy(label, splashProgress.label, sizeof(label));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while ((sequence & 1) || sequence != __atomic_load_n(&splashProgress.sequence, __ATOMIC_RELAXED));
+
+	/* progress is reported while the framework launches, before SWT could take the splash over */
+	if (sequence == shownProgress || splashBox == 0)
+		return;
+	shownProgress = sequence;
+	label[sizeof(label) - 1] = 0;
+
+	if (progressBar == 0) {
+		progressBar = gtk.gtk_progress_bar_new();
+		gtk.gtk_progress_bar_set_show_text((GtkProgressBar*) progressBar, TRUE);
+		gtk.gtk_box_pack_start((GtkBox*) splashBox, progressBar, FALSE, FALSE, 0);
+		gtk.gtk_widget_show(progressBar);
+	}
+	fraction = (total > 0) ? (double) done / total : 0;
+	gtk.gtk_progress_bar_set_fraction((GtkProgressBar*) progressBar, fraction < 0 ? 0 : (fraction > 1 ? 1 : fraction));
+	/* without a label GTK shows the percentage */
+	gtk.gtk_progress_bar_set_text((GtkProgressBar*) progressBar, label[0] != 0 ? label : NULL);
+}
+
+/* Take the progress bar out of the splash, called with the splash lock held.  SWT
+ * takes the window over with the image only, and no progress is shown afterwards.
+ */
+static void removeSplashProgress() {
+	if (progressBar != 0)
+		gtk.gtk_widget_destroy(progressBar);
+	splashBox = progressBar = 0;
+}
+
 /* Create and Display the Splash Window */
 int showSplash( const char* featureImage ) {
+	int result;
+	lockSplash();
+	result = _showSplash(featureImage);
+	unlockSplash();
+	return result;
+}
+
+static int _showSplash( const char* featureImage ) {
 	GtkWidget *image;
 	GdkPixbuf *pixbuf, *scaledPixbuf;
 	int width, height;
@@ -262,12 +475,19 @@ int showSplash( const char* featureImage ) {
 	if (pixbuf) {
 		gtk.g_object_unref(pixbuf);
 	}
-	gtk.gtk_container_add((GtkContainer*)(shellHandle), image);
+	/* the progress bar goes below the image */
+	splashBox = gtk.gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+	gtk.gtk_box_pack_start((GtkBox*)(splashBox), image, FALSE, FALSE, 0);
+	gtk.gtk_container_add((GtkContainer*)(shellHandle), splashBox);
 	
 	if (getOfficialName() != NULL)
 		gtk.gtk_window_set_title((GtkWindow*)(shellHandle), getOfficialName());
 	gtk.gtk_window_set_position((GtkWindow*)(shellHandle), GTK_WIN_POS_CENTER);
 	gtk.gtk_window_resize((GtkWindow*)(shellHandle), gtk.gdk_pixbuf_get_width(scaledPixbuf), gtk.gdk_pixbuf_get_height(scaledPixbuf));
+	/* the image has its own reference, the splash pixels go with the window */
+	if (scaledPixbuf != pixbuf && scaledPixbuf) {
+		gtk.g_object_unref(scaledPixbuf);
+	}
 	gtk.gtk_widget_show_all((GtkWidget*)(shellHandle));
 	splashHandle = shellHandle;
 	dispatchMessages();
@@ -275,21 +495,46 @@ int showSplash( const char* featureImage ) {
 }
 
 void dispatchMessages() {
+	lockSplash();
+	if (splashHandle != 0)
+		showSplashProgress();
 	if (gtk.g_main_context_iteration != 0)
 		while(gtk.g_main_context_iteration(0,0) != 0) {}
+	unlockSplash();
+}
+
+int dispatchSplashMessages() {
+	int pumping;
+	lockSplash();
+	pumping = (splashHandle != 0 && !splashHandedOut);
+	if (pumping)
+		dispatchMessages();
+	unlockSplash();
+	return pumping;
 }
 
 jlong getSplashHandle() {
-	return (jlong) splashHandle;
+	jlong result;
+	lockSplash();
+	if (splashHandle != 0) {
+		splashHandedOut = 1;
+		removeSplashProgress();
+	}
+	result = (jlong) splashHandle;
+	unlockSplash();
+	return result;
 }
 
 void takeDownSplash() {
+	lockSplash();
 	if(shellHandle != 0) {
+		removeSplashProgress();
 		gtk.gtk_widget_destroy(shellHandle);
 		dispatchMessages();
 		splashHandle = 0;
 		shellHandle = NULL;
 	}
+	unlockSplash();
 }
 
 /* Get the window system specific VM arguments */
@@ -309,22 +554,13 @@ JavaResults* launchJavaVM( char* args[] ) {
   	pid_t   jvmProcess, finishedProcess = 0;
   	int     exitCode;
   	
-	jvmProcess = fork();
-  	if (jvmProcess == 0) 
-    {
-    	/* Child process ... start the JVM */
-      	execv(args[0], args);
-
-      	/* The JVM would not start ... return error code to parent process. */
-      	/* TODO, how to distinguish this as a launch problem to the other process? */
-      	_exit(errno);
-    }
+	jvmProcess = startJavaProcess(args);
 
   	jvmResults = malloc(sizeof(JavaResults));
   	memset(jvmResults, 0, sizeof(JavaResults));
   	
 	/* If the JVM is still running, wait for it to terminate. */
-	if (jvmProcess != 0)
+	if (jvmProcess > 0)
 	{
 		/* When attempting a file open, we need to spin the event loop
 		 * for setAppWindowTimerProc to run.  When that succeeds or times out, 
@@ -339,9 +575,18 @@ JavaResults* launchJavaVM( char* args[] ) {
 			// If making any changes to this loop, ensure "./eclipse /myFile" still works.
 			while(openFileTimeout > 0 && !filesPassedToSWT && (finishedProcess = waitpid(jvmProcess, &exitCode, WNOHANG)) == 0) {
 				dispatchMessages();
+#ifdef LINUX
+				if (serveJavaProcess(jvmProcess, 500))
+					continue;
+#endif
 				nanosleep(&sleepTime, NULL);
 			}
 		}
+#ifdef LINUX
+		/* with --launcher.logTo the VM's output ends when it does, so does its control channel */
+		while (finishedProcess == 0 && serveJavaProcess(jvmProcess, 500))
+			;
+#endif
 		if (finishedProcess == 0)
 			waitpid(jvmProcess, &exitCode, 0);
       	if (WIFEXITED(exitCode))
@@ -34,9 +34,19 @@ struct GTK_PTRS {
 	void		(*gtk_window_set_decorated)	(GtkWindow*, gboolean);
 	void		(*gtk_window_set_type_hint)	(GtkWindow*, int);
 	void		(*gtk_window_set_position)	(GtkWindow*, GtkWindowPosition);
+	GtkWidget*	(*gtk_box_new)				(GtkOrientation, gint);
+	void		(*gtk_box_pack_start)		(GtkBox*, GtkWidget*, gboolean, gboolean, guint);
+	GtkWidget*	(*gtk_progress_bar_new)		();
+	void		(*gtk_progress_bar_set_fraction)	(GtkProgressBar*, gdouble);
+	void		(*gtk_progress_bar_set_text)		(GtkProgressBar*, const gchar*);
+	void		(*gtk_progress_bar_set_show_text)	(GtkProgressBar*, gboolean);
+	void		(*gtk_widget_show)			(GtkWidget*);
 
 	gulong 		(*g_signal_connect_data)	(gpointer, const gchar*, GCallback, gpointer, GClosureNotify, GConnectFlags);
 	gboolean	(*g_main_context_iteration)	(GMainContext*, gboolean);
+	gboolean	(*g_main_context_acquire)	(GMainContext*);
+	void		(*g_main_context_release)	(GMainContext*);
+	gboolean	(*g_source_remove)			(guint);
 	void		(*g_object_unref)			(gpointer);
 	guint       (*g_timeout_add)			(guint, GSourceFunc, gpointer);
 	void		(*g_error_free)				(GError *);
@@ -74,4 +84,12 @@ typedef struct {
 /* load the gtk libraries and initialize the function pointers */
 extern int loadGtk();
 
+/* close the libraries loaded by loadGtk(), they stay loaded as long as something else uses them */
+extern void unloadGtk();
+
+/* map the gtk and gdk libraries without resolving any symbols, loadGtk() then finds them loaded */
+extern void preloadGtk();
+
+extern gboolean gtkInitialized;
+
 #endif
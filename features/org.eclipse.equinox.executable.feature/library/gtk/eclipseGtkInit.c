@@ -20,6 +20,10 @@
 
 struct GTK_PTRS gtk = { 1 }; /* initialize the first field "not_initialized" so we can tell when we've loaded the pointers */
 
+static void *gioLib = NULL, *glibLib = NULL, *gdkLib = NULL, *gtkLib = NULL, *objLib = NULL, *pixLib = NULL;
+static int gtkLoaded = 0;
+static void *preloadedLibs[] = { NULL, NULL };	/* opened by preloadGtk() */
+
 static _TCHAR* minVerMsg1 = _T_ECLIPSE("Starting from the Eclipse 4.7 (Oxygen) release, \nGTK+ versions below");
 static _TCHAR* minVerMsg2 = _T_ECLIPSE("are not supported.\nGTK+ version found is");
 static _TCHAR* minVerTitle = _T_ECLIPSE("Unsupported GTK+ version");
@@ -47,6 +51,13 @@ static FN_TABLE gtkFunctions[] = {
 	FN_TABLE_ENTRY(gtk_window_set_decorated, 1),
 	FN_TABLE_ENTRY(gtk_window_set_type_hint, 1),
 	FN_TABLE_ENTRY(gtk_window_set_position, 1),
+	FN_TABLE_ENTRY(gtk_box_new, 1),
+	FN_TABLE_ENTRY(gtk_box_pack_start, 1),
+	FN_TABLE_ENTRY(gtk_progress_bar_new, 1),
+	FN_TABLE_ENTRY(gtk_progress_bar_set_fraction, 1),
+	FN_TABLE_ENTRY(gtk_progress_bar_set_text, 1),
+	FN_TABLE_ENTRY(gtk_progress_bar_set_show_text, 1),
+	FN_TABLE_ENTRY(gtk_widget_show, 1),
 	{ NULL, NULL }
 };
 /* functions from libgdk-3.so.0*/
@@ -83,6 +94,9 @@ static FN_TABLE pixFunctions[] = {
 static FN_TABLE gobjFunctions[] = {
 	FN_TABLE_ENTRY(g_signal_connect_data, 1),
 	FN_TABLE_ENTRY(g_main_context_iteration, 1),
+	FN_TABLE_ENTRY(g_main_context_acquire, 1),
+	FN_TABLE_ENTRY(g_main_context_release, 1),
+	FN_TABLE_ENTRY(g_source_remove, 1),
 	FN_TABLE_ENTRY(g_object_unref, 1),
 	FN_TABLE_ENTRY(g_timeout_add, 1),
 	FN_TABLE_ENTRY(g_error_free, 1),
@@ -114,8 +128,9 @@ int loadGtk() {
 #define DLFLAGS RTLD_LAZY
 #endif
 
-	void *gioLib = NULL, *glibLib = NULL, *gdkLib = NULL, *gtkLib = NULL, *objLib = NULL, *pixLib = NULL;
-	
+	if (gtkLoaded)
+		return 0;
+
 	gdkLib = dlopen(GDK3_LIB, DLFLAGS);
 	gtkLib = dlopen(GTK3_LIB, DLFLAGS);
 
@@ -200,5 +215,28 @@ int loadGtk() {
 	if ( pixLib == NULL || loadGtkSymbols(pixLib, pixFunctions)  != 0) return -1;
 	if ( objLib == NULL || loadGtkSymbols(objLib, gobjFunctions) != 0) return -1;
 
+	gtkLoaded = 1;
 	return 0;
 }
+
+void preloadGtk() {
+	if (preloadedLibs[0] == NULL)
+		preloadedLibs[0] = dlopen(GDK3_LIB, DLFLAGS);
+	if (preloadedLibs[1] == NULL)
+		preloadedLibs[1] = dlopen(GTK3_LIB, DLFLAGS);
+}
+
+void unloadGtk() {
+	void** libraries[] = { &gtkLib, &gdkLib, &pixLib, &gioLib, &objLib, &glibLib, &preloadedLibs[1], &preloadedLibs[0], NULL };
+	int i;
+
+	for (i = 0; libraries[i] != NULL; i++) {
+		if (*libraries[i] != NULL) {
+			dlclose(*libraries[i]);
+			*libraries[i] = NULL;
+		}
+	}
+	memset(&gtk, 0, sizeof(struct GTK_PTRS));
+	gtk.not_initialized = 1;
+	gtkLoaded = 0;
+}
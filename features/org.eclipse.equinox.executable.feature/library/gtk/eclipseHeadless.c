@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* Window system functions of the headless launcher (make_linux.mak headless)
+ *
+ * Replaces eclipseGtk.c, eclipseGtkCommon.c and eclipseGtkInit.c: there is no
+ * splash, no D-Bus and messages go to the console.  The launcher library is
+ * linked into the executable, and the VM is always exec'd.
+ */
+
+#include "eclipseCommon.h"
+#include "eclipseOS.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Global Variables */
+char   dirSeparator  = '/';
+char   pathSeparator = ':';
+char*  defaultVM     = "java";
+char*  vmLibrary 	 = "libjvm.so";
+char*  shippedVMDir  = "jre/bin/";
+
+static char* argVM_JAVA[] = { NULL };
+
+void displayMessage(char* title, char* message) {
+	printf("%s:\n%s\n", title, message);
+}
+
+int initWindowSystem(int* pArgc, char* argv[], int showSplash) {
+	return -1;
+}
+
+/* Nothing is loaded at runtime besides the VM, which is exec'd */
+void * loadLibrary( char * library ) {
+	return NULL;
+}
+
+void unloadLibrary( void * handle ) {
+}
+
+void * findSymbol( void * handle, char * symbol ) {
+	return NULL;
+}
+
+/* Files are handed to a running instance through eclipseHandoff.c only */
+int reuseWorkbench(_TCHAR** filePath, int timeout) {
+	return 0;
+}
+
+void releaseWindowSystem() {
+}
+
+void preloadWindowSystem() {
+}
+
+int forwardFileOpen(_TCHAR** filePath) {
+	return 0;
+}
+
+int showSplash( const char* featureImage ) {
+	return -1;
+}
+
+void dispatchMessages() {
+}
+
+int dispatchSplashMessages() {
+	return 0;
+}
+
+void acquireMainContext() {
+}
+
+void handOverMainContext() {
+}
+
+int serveFileOpen() {
+	return 0;
+}
+
+void updateSplashProgress(int done, int total, const char* label) {
+}
+
+jlong getSplashHandle() {
+	return 0;
+}
+
+void takeDownSplash() {
+}
+
+char** getArgVM( char* vm ) {
+	return argVM_JAVA;
+}
+
+JavaResults* launchJavaVM( char* args[] ) {
+	JavaResults* jvmResults = malloc(sizeof(JavaResults));
+	int process, exitCode;
+
+	memset(jvmResults, 0, sizeof(JavaResults));
+	process = startJavaProcess(args);
+	/* with --launcher.logTo the VM's output ends when it does, so does its control channel */
+	while (process > 0 && serveJavaProcess(process, 500))
+		;
+	if (process < 0)
+		jvmResults->launchResult = -1;
+	else if ((exitCode = waitJavaProcess(process)) >= 0)
+		jvmResults->launchResult = exitCode;
+	return jvmResults;
+}
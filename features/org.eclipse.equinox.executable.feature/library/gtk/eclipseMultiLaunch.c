@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (c) 2026 Eclipse Foundation and others.
+ *
+ * This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License 2.0
+ * which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-2.0/
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *     Eclipse Foundation - initial API and implementation
+ *******************************************************************************/
+
+/* eclipse-multilaunch: start several VMs of an installation side by side through eclipseLaunch.h
+ *
+ *     eclipse-multilaunch -library <eclipse_XXXX.so> [-count <n>] <eclipse> [<launcher arguments>]
+ *
+ * The tool loads the eclipse library like a host process embedding it would,
+ * and runs count launches at once, each on a thread of its own with a
+ * LaunchContext of its own: prepareLaunch() with "<eclipse> <launcher arguments>",
+ * resolveLaunch(), launchJavaExe() and waitForLaunch().  It prints the command
+ * of the first launch and the process and exit code of each, and exits with 1
+ * if a launch could not be resolved or started.
+ */
+
+#include "eclipseLaunch.h"
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef LaunchContext* (*PrepareLaunch)(int argc, char* argv[], char* vmArgs[]);
+typedef int (*ResolveLaunch)(LaunchContext* context, char** msg);
+typedef char** (*GetLaunchCommand)(LaunchContext* context);
+typedef int (*LaunchJavaExe)(LaunchContext* context);
+typedef int (*WaitForLaunch)(LaunchContext* context, char** exitData);
+typedef void (*FreeLaunch)(LaunchContext* context);
+
+static PrepareLaunch	prepare;
+static ResolveLaunch	resolve;
+static GetLaunchCommand	getCommand;
+static LaunchJavaExe	launch;
+static WaitForLaunch	waitFor;
+static FreeLaunch		freeContext;
+
+static int    launchArgc;
+static char** launchArgv;
+
+static pthread_mutex_t outputLock = PTHREAD_MUTEX_INITIALIZER;
+
+typedef struct {
+	int index;
+	int failed;
+} Launch;
+
+static void* runLaunch(void* data) {
+	Launch* run = (Launch*) data;
+	LaunchContext* context = prepare(launchArgc, launchArgv, NULL);
+	char* msg = NULL;
+	char* exitData = NULL;
+	char** command;
+	int process, exitCode, i;
+
+	if (resolve(context, &msg) != 0) {
+		pthread_mutex_lock(&outputLock);
+		fprintf(stderr, "launch %d: %s\n", run->index, msg != NULL ? msg : "unable to resolve");
+		pthread_mutex_unlock(&outputLock);
+		free(msg);
+		freeContext(context);
+		run->failed = 1;
+		return NULL;
+	}
+	if (run->index == 0) {
+		pthread_mutex_lock(&outputLock);
+		command = getCommand(context);
+		for (i = 0; command[i] != NULL; i++)
+			printf(i == 0 ? "%s" : " %s", command[i]);
+		printf("\n");
+		pthread_mutex_unlock(&outputLock);
+	}
+
+	process = launch(context);
+	if (process < 0) {
+		pthread_mutex_lock(&outputLock);
+		fprintf(stderr, "launch %d: unable to start the VM\n", run->index);
+		pthread_mutex_unlock(&outputLock);
+		freeContext(context);
+		run->failed = 1;
+		return NULL;
+	}
+	exitCode = waitFor(context, &exitData);
+
+	pthread_mutex_lock(&outputLock);
+	printf("launch %d: process %d exited with %d%s\n", run->index, process, exitCode, exitData != NULL ? ", exit data left" : "");
+	pthread_mutex_unlock(&outputLock);
+	free(exitData);
+	freeContext(context);
+	return NULL;
+}
+
+static void* findFunction(void* library, const char* name) {
+	void* function = dlsym(library, name);
+	if (function == NULL)
+		fprintf(stderr, "%s not found: %s\n", name, dlerror());
+	return function;
+}
+
+int main(int argc, char* argv[]) {
+	char* libraryPath = NULL;
+	void* library;
+	Launch* runs;
+	pthread_t* threads;
+	int count = 4, result = 0, i;
+
+	for (i = 1; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+		if (strcmp(argv[i], "-library") == 0)
+			libraryPath = argv[i + 1];
+		else if (strcmp(argv[i], "-count") == 0)
+			count = atoi(argv[i + 1]);
+		else
+			break;
+	}
+	if (libraryPath == NULL || i >= argc || count < 1) {
+		fprintf(stderr, "usage: %s -library <eclipse_XXXX.so> [-count <n>] <eclipse> [<launcher arguments>]\n", argv[0]);
+		return 2;
+	}
+	launchArgc = argc - i;
+	launchArgv = argv + i;
+
+	library = dlopen(libraryPath, RTLD_NOW);
+	if (library == NULL) {
+		fprintf(stderr, "%s\n", dlerror());
+		return 1;
+	}
+	prepare = (PrepareLaunch) findFunction(library, "prepareLaunch");
+	resolve = (ResolveLaunch) findFunction(library, "resolveLaunch");
+	getCommand = (GetLaunchCommand) findFunction(library, "getLaunchCommand");
+	launch = (LaunchJavaExe) findFunction(library, "launchJavaExe");
+	waitFor = (WaitForLaunch) findFunction(library, "waitForLaunch");
+	freeContext = (FreeLaunch) findFunction(library, "freeLaunch");
+	if (prepare == NULL || resolve == NULL || getCommand == NULL || launch == NULL || waitFor == NULL || freeContext == NULL)
+		return 1;
+
+	runs = calloc(count, sizeof(Launch));
+	threads = calloc(count, sizeof(pthread_t));
+	for (i = 0; i < count; i++) {
+		runs[i].index = i;
+		if (pthread_create(&threads[i], NULL, runLaunch, &runs[i]) != 0) {
+			fprintf(stderr, "launch %d: unable to create a thread\n", i);
+			count = i;
+			result = 1;
+		}
+	}
+	for (i = 0; i < count; i++) {
+		pthread_join(threads[i], NULL);
+		if (runs[i].failed)
+			result = 1;
+	}
+	free(threads);
+	free(runs);
+	return result;
+}
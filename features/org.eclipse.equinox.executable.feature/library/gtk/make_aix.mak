@@ -69,7 +69,7 @@ CFLAGS = ${M_ARCH} -g -s -Wall\
 
 all: $(EXEC) $(DLL)
 
-eclipse.o: ../eclipse.c ../eclipseOS.h ../eclipseCommon.h ../eclipseJNI.h
+eclipse.o: ../eclipse.c ../eclipseOS.h ../eclipseCommon.h ../eclipseJNI.h ../eclipseLaunch.h
 	$(CC) $(CFLAGS) -c ../eclipse.c -o eclipse.o
 
 eclipseMain.o: ../eclipseUnicode.h ../eclipseCommon.h ../eclipseMain.c 
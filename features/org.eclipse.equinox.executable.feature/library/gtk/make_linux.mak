@@ -23,6 +23,10 @@ include ../make_version.mak
 # make -f make_linux.mak clean all
 # make -f make_linux.mak clean all install # Install as part of eclipse build.
 # make -f make_linux.mak clean all dev_build_install   # For development/testing of launcher, install into your development eclipse, see target below.
+# make -f make_linux.mak clean headless  # Static launcher without GTK or companion library, for servers and CI.
+# make -f make_linux.mak stamp  # eclipse-stamp <launcher> <ini>, writes the launcher.ini into the executable at packaging time.
+# make -f make_linux.mak all fileopen_bench  # eclipse-fileopen-bench -launcher ./eclipse, file open handoff latency over a private D-Bus, see eclipseFileOpenBench.c.
+# make -f make_linux.mak all multilaunch  # eclipse-multilaunch -library eclipse_XXXX.so ./eclipse, several VMs through the embedding API of eclipseLaunch.h.
 
 # This makefile expects the utility "pkg-config" to be in the PATH.
 # This makefile expects the following environment variables be set. If they are not set, it will figure out reasonable defaults targeting linux build.
@@ -80,12 +84,24 @@ $(info Input info: $(INFO_PROG) $(INFO_ARCH) $(INFO_JAVA) $(INFO_OUT_LIB_DIRS))
 # Define the object modules to be compiled and flags.
 MAIN_OBJS = eclipseMain.o
 COMMON_OBJS = eclipseConfig.o eclipseCommon.o eclipseGtkCommon.o eclipseGtkInit.o
-DLL_OBJS	= eclipse.o eclipseGtk.o eclipseUtil.o eclipseJNI.o eclipseShm.o eclipseNix.o
+DLL_OBJS	= eclipse.o eclipseGtk.o eclipseUtil.o eclipseJNI.o eclipseShm.o eclipseNix.o eclipseCheckpoint.o eclipseJdk.o eclipsePrefetch.o eclipseHandoff.o eclipseStall.o eclipseProfile.o eclipseLog.o eclipseCgroup.o eclipseRuntime.o eclipseControl.o eclipseMemory.o eclipseAdmission.o
 
 EXEC = $(PROGRAM_OUTPUT)
 # DLL == 'eclipse_XXXX.so'
 DLL = $(PROGRAM_LIBRARY)
 
+STAMP_EXEC = $(PROGRAM_OUTPUT)-stamp
+FILEOPEN_BENCH_EXEC = $(PROGRAM_OUTPUT)-fileopen-bench
+MULTILAUNCH_EXEC = $(PROGRAM_OUTPUT)-multilaunch
+
+# The headless launcher links the library in and replaces the GTK code with eclipseHeadless.c.
+# It has no splash and always execs java, a static executable can't load libjvm.
+HEADLESS_EXEC = $(PROGRAM_OUTPUT)-headless
+HEADLESS_OBJS = eclipseMain-headless.o eclipse-headless.o eclipseConfig-headless.o eclipseCommon-headless.o \
+ eclipseUtil-headless.o eclipseJNI-headless.o eclipseShm-headless.o eclipseNix-headless.o \
+ eclipseCheckpoint-headless.o eclipseJdk-headless.o eclipsePrefetch-headless.o eclipseHandoff-headless.o \
+ eclipseStall-headless.o eclipseProfile-headless.o eclipseLog-headless.o eclipseCgroup-headless.o eclipseRuntime-headless.o eclipseControl-headless.o eclipseMemory-headless.o eclipseAdmission-headless.o eclipseHeadless.o
+
 LIBS = -lpthread -ldl
 GTK_LIBS = \
  -DGTK3_LIB="\"libgtk-3.so.0\"" -DGDK3_LIB="\"libgdk-3.so.0\"" \
@@ -104,13 +120,23 @@ CFLAGS = ${M_CFLAGS} ${M_ARCH} -g -s -Wall\
 	-I.. \
 	-I$(JAVA_HOME)/include -I$(JAVA_HOME)/include/linux \
 	`pkg-config --cflags gtk+-3.0`
+HEADLESS_CFLAGS = ${M_CFLAGS} ${M_ARCH} -g -s -Wall\
+	-DLINUX \
+	-DHEADLESS \
+	-DDEFAULT_OS="\"$(DEFAULT_OS)\"" \
+	-DDEFAULT_OS_ARCH="\"$(DEFAULT_OS_ARCH)\"" \
+	-DDEFAULT_WS="\"$(DEFAULT_WS)\"" \
+	-DDEFAULT_JAVA_EXEC \
+	-I. \
+	-I.. \
+	-I$(JAVA_HOME)/include -I$(JAVA_HOME)/include/linux
 
 all: $(EXEC) $(DLL)
 
-eclipse.o: ../eclipse.c ../eclipseOS.h ../eclipseCommon.h ../eclipseJNI.h
+eclipse.o: ../eclipse.c ../eclipseOS.h ../eclipseCommon.h ../eclipseJNI.h ../eclipseCheckpoint.h ../eclipseJdk.h ../eclipsePrefetch.h ../eclipseLaunch.h ../eclipseHandoff.h ../eclipseStall.h ../eclipseProfile.h ../eclipseLog.h ../eclipseCgroup.h ../eclipseRuntime.h ../eclipseControl.h ../eclipseMemory.h ../eclipseAdmission.h
 	$(CC) $(CFLAGS) -c ../eclipse.c -o eclipse.o
 
-eclipseMain.o: ../eclipseUnicode.h ../eclipseCommon.h ../eclipseMain.c
+eclipseMain.o: ../eclipseUnicode.h ../eclipseCommon.h ../eclipseStamp.h ../eclipseMain.c
 	$(info Starting Build:)
 	$(CC) $(CFLAGS) -c ../eclipseMain.c -o eclipseMain.o
 
@@ -138,6 +164,42 @@ eclipseShm.o: ../eclipseShm.h ../eclipseUnicode.h ../eclipseShm.c
 eclipseNix.o: ../eclipseNix.c
 	$(CC) $(CFLAGS) -c ../eclipseNix.c -o eclipseNix.o
 
+eclipseCheckpoint.o: ../eclipseCheckpoint.h ../eclipseCheckpoint.c
+	$(CC) $(CFLAGS) -c ../eclipseCheckpoint.c -o eclipseCheckpoint.o
+
+eclipseJdk.o: ../eclipseJdk.h ../eclipseUtil.h ../eclipseJdk.c
+	$(CC) $(CFLAGS) -c ../eclipseJdk.c -o eclipseJdk.o
+
+eclipsePrefetch.o: ../eclipsePrefetch.h ../eclipseUtil.h ../eclipsePrefetch.c
+	$(CC) $(CFLAGS) -c ../eclipsePrefetch.c -o eclipsePrefetch.o
+
+eclipseHandoff.o: ../eclipseHandoff.h ../eclipseHandoff.c
+	$(CC) $(CFLAGS) -c ../eclipseHandoff.c -o eclipseHandoff.o
+
+eclipseStall.o: ../eclipseStall.h ../eclipseStall.c
+	$(CC) $(CFLAGS) -c ../eclipseStall.c -o eclipseStall.o
+
+eclipseProfile.o: ../eclipseProfile.h ../eclipseProfile.c
+	$(CC) $(CFLAGS) -c ../eclipseProfile.c -o eclipseProfile.o
+
+eclipseLog.o: ../eclipseLog.h ../eclipseLog.c
+	$(CC) $(CFLAGS) -c ../eclipseLog.c -o eclipseLog.o
+
+eclipseCgroup.o: ../eclipseCgroup.h ../eclipseCgroup.c
+	$(CC) $(CFLAGS) -c ../eclipseCgroup.c -o eclipseCgroup.o
+
+eclipseRuntime.o: ../eclipseRuntime.h ../eclipseRuntime.c
+	$(CC) $(CFLAGS) -c ../eclipseRuntime.c -o eclipseRuntime.o
+
+eclipseControl.o: ../eclipseControl.h ../eclipseControl.c
+	$(CC) $(CFLAGS) -c ../eclipseControl.c -o eclipseControl.o
+
+eclipseMemory.o: ../eclipseMemory.h ../eclipseMemory.c
+	$(CC) $(CFLAGS) -c ../eclipseMemory.c -o eclipseMemory.o
+
+eclipseAdmission.o: ../eclipseAdmission.h ../eclipseAdmission.c
+	$(CC) $(CFLAGS) -c ../eclipseAdmission.c -o eclipseAdmission.o
+
 $(EXEC): $(MAIN_OBJS) $(COMMON_OBJS)
 	$(info Linking and generating: $(EXEC))
 	$(CC) ${M_ARCH} -o $(EXEC) $(MAIN_OBJS) $(COMMON_OBJS) $(LIBS)
@@ -146,6 +208,36 @@ $(DLL): $(DLL_OBJS) $(COMMON_OBJS)
 	$(info Linking and generating: $(DLL))
 	$(CC) $(LFLAGS) -o $(DLL) $(DLL_OBJS) $(COMMON_OBJS) $(LIBS)
 
+headless: $(HEADLESS_EXEC)
+
+%-headless.o: ../%.c ../eclipseOS.h ../eclipseCommon.h
+	$(CC) $(HEADLESS_CFLAGS) -c $< -o $@
+
+eclipseHeadless.o: ../eclipseOS.h ../eclipseCommon.h eclipseHeadless.c
+	$(CC) $(HEADLESS_CFLAGS) -c eclipseHeadless.c -o eclipseHeadless.o
+
+$(HEADLESS_EXEC): $(HEADLESS_OBJS)
+	$(info Linking and generating: $(HEADLESS_EXEC))
+	$(CC) ${M_ARCH} -static -o $(HEADLESS_EXEC) $(HEADLESS_OBJS) $(LIBS)
+
+stamp: $(STAMP_EXEC)
+
+$(STAMP_EXEC): ../eclipseStamp.h ../eclipseStamp.c
+	$(info Linking and generating: $(STAMP_EXEC))
+	$(CC) -g -Wall -I.. -o $(STAMP_EXEC) ../eclipseStamp.c
+
+fileopen_bench: $(FILEOPEN_BENCH_EXEC)
+
+$(FILEOPEN_BENCH_EXEC): eclipseFileOpenBench.c
+	$(info Linking and generating: $(FILEOPEN_BENCH_EXEC))
+	$(CC) ${M_ARCH} -g -Wall -o $(FILEOPEN_BENCH_EXEC) eclipseFileOpenBench.c `pkg-config --cflags --libs gio-2.0` $(LIBS)
+
+multilaunch: $(MULTILAUNCH_EXEC)
+
+$(MULTILAUNCH_EXEC): ../eclipseLaunch.h eclipseMultiLaunch.c
+	$(info Linking and generating: $(MULTILAUNCH_EXEC))
+	$(CC) ${M_ARCH} -g -Wall -I.. -o $(MULTILAUNCH_EXEC) eclipseMultiLaunch.c $(LIBS)
+
 install: all
 	cp $(EXEC) $(OUTPUT_DIR)
 	cp $(DLL) $(LIBRARY_DIR)
@@ -153,7 +245,7 @@ install: all
 
 clean:
 	$(info Clean up:)
-	rm -f $(EXEC) $(DLL) $(MAIN_OBJS) $(COMMON_OBJS) $(DLL_OBJS)
+	rm -f $(EXEC) $(DLL) $(MAIN_OBJS) $(COMMON_OBJS) $(DLL_OBJS) $(HEADLESS_EXEC) $(HEADLESS_OBJS) $(STAMP_EXEC) $(FILEOPEN_BENCH_EXEC) $(MULTILAUNCH_EXEC)
 
 # Convienience method to install produced output into a developer's eclipse for testing/development.
 dev_build_install: all